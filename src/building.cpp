@@ -3,7 +3,8 @@
 
 using namespace std;
 
-Building::Building(const string& name, const BuildingType& type):
+Building::Building(const string& name, const BuildingType& type, const Location& location):
     name(name),
-    type(type)
+    type(type),
+    location(location)
     {}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 #include <string>
+#include "location.h"
+
+constexpr int BUILDING_TYPES=3;
 
 enum class BuildingType {
     SINGLE_STORY,
@@ -11,5 +14,6 @@ class Building {
     public:
         std::string name;
         BuildingType type;
-        Building(const std::string& name, const BuildingType& type);
+        Location location;
+        Building(const std::string& name, const BuildingType& type, const Location& location = {});
 };
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include "employee.h"
+#include "building.h"
+
+
+// one alternative of the requirement table, the staff counts are indexed by employee type
+template <std::size_t EmployeeTypes>
+struct StaticRequirement {
+    BuildingType buildingType;
+    std::array<int, EmployeeTypes> staff;
+};
+
+// The building rules, the single source of Scheduler::buildingRequirements and of DefaultStaticScheduler.
+// The alternatives of a building type are tried in the listed order, the first one that can be staffed wins.
+inline constexpr std::array<StaticRequirement<EMPLOYEE_TYPES>, 6> defaultBuildingRequirements = {{
+    {BuildingType::SINGLE_STORY, {1, 0, 0}},
+    {BuildingType::TWO_STORY, {1, 0, 1}},
+    {BuildingType::TWO_STORY, {1, 1, 0}},
+    {BuildingType::COMMERCIAL, {2, 2, 4}},
+    {BuildingType::COMMERCIAL, {6, 2, 0}},
+    {BuildingType::COMMERCIAL, {2, 6, 0}}
+}};
@@ -0,0 +1,114 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+
+// LEB128 varints and native-order doubles appended to a byte string, read back with ByteReader
+inline void putVarint(std::string& bytes, std::uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<char>(value));
+}
+
+// zigzag keeps small negative values short
+inline void putSigned(std::string& bytes, std::int64_t value) {
+    putVarint(bytes, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+inline void putDouble(std::string& bytes, double value) {
+    bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+inline void putText(std::string& bytes, std::string_view text) {
+    putVarint(bytes, text.size());
+    bytes.append(text);
+}
+
+// bounds-checked reader, throws std::runtime_error naming the kind of data on malformed input
+class ByteReader {
+    public:
+        ByteReader(std::string_view bytes, const char* what):
+            __bytes(bytes),
+            __pos(0),
+            __what(what)
+            {}
+
+        bool atEnd() const {
+            return __pos == __bytes.size();
+        }
+
+        [[noreturn]] void fail(const std::string& problem) const {
+            throw std::runtime_error(std::string(__what) + " " + problem);
+        }
+
+        std::uint8_t getByte() {
+            if (__pos == __bytes.size()) {
+                fail("is truncated");
+            }
+            return static_cast<std::uint8_t>(__bytes[__pos++]);
+        }
+
+        std::uint64_t getVarint() {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                std::uint8_t byte = getByte();
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            fail("has an overlong varint");
+        }
+
+        std::int64_t getSigned() {
+            std::uint64_t value = getVarint();
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+
+        std::int32_t getInt() {
+            std::int64_t value = getSigned();
+            if (value < INT32_MIN || value > INT32_MAX) {
+                fail("has an out of range value");
+            }
+            return static_cast<std::int32_t>(value);
+        }
+
+        // counts are checked against the bytes left, every element takes at least one byte
+        std::size_t getCount() {
+            std::uint64_t count = getVarint();
+            if (count > __bytes.size() - __pos) {
+                fail("has an invalid count");
+            }
+            return static_cast<std::size_t>(count);
+        }
+
+        std::string_view get(std::size_t count) {
+            if (count > __bytes.size() - __pos) {
+                fail("is truncated");
+            }
+            std::string_view bytes = __bytes.substr(__pos, count);
+            __pos += count;
+            return bytes;
+        }
+
+        std::string_view getText() {
+            return get(getCount());
+        }
+
+        double getDouble() {
+            double value;
+            std::memcpy(&value, get(sizeof(value)).data(), sizeof(value));
+            return value;
+        }
+
+    private:
+        std::string_view __bytes;
+        std::size_t __pos;
+        const char* __what;
+};
@@ -0,0 +1,25 @@
+#include "capacity_report.h"
+
+using namespace std;
+
+namespace {
+const array<pair<const char*, const char*>, EMPLOYEE_TYPES> employeeTypeNames = {{
+    {"certified installer", "certified installers"},
+    {"installer pending certification", "installers pending certification"},
+    {"laborer", "laborers"}
+}};
+}
+
+std::vector<std::string> CapacityReport::describe() const {
+    vector<string> lines;
+    for (DayOfWeek day = DayOfWeek::MONDAY; static_cast<int>(day) < WORK_DAYS; ++day) {
+        for (int type = 0; type < EMPLOYEE_TYPES; type++) {
+            int missing = gap[static_cast<int>(day)][type];
+            if (missing > 0) {
+                const auto& [singular, plural] = employeeTypeNames[type];
+                lines.push_back("need " + to_string(missing) + " more " + (missing == 1 ? singular : plural) + " on " + dayToStr.at(day));
+            }
+        }
+    }
+    return lines;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <array>
+#include "employee.h"
+#include "building.h"
+#include "days.h"
+
+
+// why a building could not be staffed on one day, for the requirement alternative missing the fewest employees
+struct DayShortfall {
+    int alternative = -1; //position among the alternatives of the building type, -1 when the day was not tried
+    std::array<int, EMPLOYEE_TYPES> required{}; //staff of that alternative by employee type
+    std::array<int, EMPLOYEE_TYPES> missing{};  //employees short by type when the building was tried
+
+    int totalMissing() const {
+        int total = 0;
+        for (int count : missing) {
+            total += count;
+        }
+        return total;
+    }
+};
+
+struct UnscheduledBuilding {
+    std::string name;
+    BuildingType type;
+    std::array<DayShortfall, WORK_DAYS> days;
+    int closestDay = -1; //tried day with the smallest shortfall, earliest on ties
+};
+
+// Diagnostics of the last schedule() run, see Scheduler::setDiagnostics. The gap is the number of extra employees
+// by day and type needed to staff every unscheduled building on its closest day, on top of who was still free.
+struct CapacityReport {
+    std::vector<UnscheduledBuilding> unscheduled;
+    std::array<std::array<int, EMPLOYEE_TYPES>, WORK_DAYS> gap{};
+
+    std::vector<std::string> describe() const; //one line per day and type short, e.g. "need 2 more laborers on Thursday"
+};
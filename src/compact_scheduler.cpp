@@ -0,0 +1,214 @@
+#include <iostream>
+#include <algorithm>
+
+#include "compact_scheduler.h"
+#include "scheduler.h"
+
+using namespace std;
+
+namespace {
+// multiplicative hashing, the slot count is a power of two
+inline size_t slotOf(uint32_t employeeId, size_t slotCount) {
+    return (static_cast<uint64_t>(employeeId) * 0x9E3779B97F4A7C15ull >> 32) & (slotCount - 1);
+}
+}
+
+CompactScheduler::CompactScheduler():
+    __employees(),
+    __employee_slots(),
+    __employees_by_type_and_day(),
+    __buildings(),
+    __pending_buildings(),
+    __daily_schedule(),
+    __crews()
+    {}
+
+
+uint32_t CompactScheduler::__findEmployee(const uint32_t& employeeId) const {
+    if (__employee_slots.empty()) {
+        return __EMPTY_SLOT;
+    }
+    for (size_t slot = slotOf(employeeId, __employee_slots.size()); ; slot = (slot + 1) & (__employee_slots.size() - 1)) {
+        uint32_t index = __employee_slots[slot];
+        if (index == __EMPTY_SLOT || __employees[index].id == employeeId) {
+            return index;
+        }
+    }
+}
+
+void CompactScheduler::__insertSlot(const uint32_t& index) {
+    size_t slot = slotOf(__employees[index].id, __employee_slots.size());
+    while (__employee_slots[slot] != __EMPTY_SLOT) {
+        slot = (slot + 1) & (__employee_slots.size() - 1);
+    }
+    __employee_slots[slot] = index;
+}
+
+void CompactScheduler::__growSlots() {
+    // keeps the load factor at or below 3/4
+    size_t slot_count = max<size_t>(16, __employee_slots.size());
+    while (__employees.size() * 4 > slot_count * 3) {
+        slot_count *= 2;
+    }
+    if (slot_count == __employee_slots.size()) {
+        return;
+    }
+    __employee_slots.assign(slot_count, __EMPTY_SLOT);
+    for (uint32_t index = 0; index < __employees.size(); index++) {
+        __insertSlot(index);
+    }
+}
+
+void CompactScheduler::addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability) {
+    uint8_t availability = 0;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        availability |= static_cast<uint8_t>(empAvailability[day]) << day;
+    }
+
+    uint32_t index = __findEmployee(employeeId);
+    if (index == __EMPTY_SLOT) {
+        index = static_cast<uint32_t>(__employees.size());
+        __employees.push_back(__CompactEmployee{static_cast<uint32_t>(employeeId), static_cast<uint8_t>(empType), availability});
+        if (__employees.size() * 4 > __employee_slots.size() * 3) {
+            __growSlots();
+        } else {
+            __insertSlot(index);
+        }
+    } else {
+        // added again: the record is replaced, so it leaves the pools of its old type and days first
+        for (auto& pool : __employees_by_type_and_day[__employees[index].type]) {
+            std::erase(pool, index);
+        }
+        __employees[index].type = static_cast<uint8_t>(empType);
+        __employees[index].availability = availability;
+    }
+
+    auto& pools = __employees_by_type_and_day[static_cast<int>(empType)];
+    for (int day = 0; day < WORK_DAYS; day++) {
+        if (empAvailability[day]) {
+            pools[day].push_back(index);
+        }
+    }
+}
+
+void CompactScheduler::addBuilding(const std::string& buildName, const BuildingType& buildType) {
+    __pending_buildings.push_back(static_cast<uint32_t>(__buildings.size()));
+    __buildings.push_back(__CompactBuilding{SmallString(buildName), static_cast<uint8_t>(buildType)});
+}
+
+void CompactScheduler::updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability) {
+    uint32_t index = __findEmployee(employeeId);
+    if (index == __EMPTY_SLOT) {
+        return;
+    }
+    auto& pools = __employees_by_type_and_day[__employees[index].type];
+    uint8_t availability = 0;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        auto& pool = pools[day];
+        auto was_available_already = find(pool.begin(), pool.end(), index);
+        if (newAvailability[day]) {
+            availability |= uint8_t{1} << day;
+            if (was_available_already == pool.end()) {
+                pool.push_back(index);
+            }
+        } else if (was_available_already != pool.end()) {
+            pool.erase(was_available_already);
+        }
+    }
+    __employees[index].availability = availability;
+}
+
+void CompactScheduler::schedule() {
+    for (int day = 0; day < WORK_DAYS; day++) {
+        // stable in-place compaction of the buildings left, keeps their order
+        auto remaining = __pending_buildings.begin();
+        for (auto it = __pending_buildings.begin(); it != __pending_buildings.end(); ++it) {
+            uint32_t crew_begin = static_cast<uint32_t>(__crews.size());
+            if (__canBuild(__buildings[*it], day)) {
+                __daily_schedule[day].push_back(__ScheduleEntry{*it, crew_begin, static_cast<uint32_t>(__crews.size()) - crew_begin});
+            } else {
+                *remaining++ = *it;
+            }
+        }
+        __pending_buildings.erase(remaining, __pending_buildings.end());
+    }
+}
+
+bool CompactScheduler::__canBuild(const __CompactBuilding& building, int day) {
+    const auto* alternative = Scheduler::staffableAlternative(Scheduler::buildingRequirements, static_cast<BuildingType>(building.type),
+        [&](const EmployeeType& empType) { return __employees_by_type_and_day[static_cast<int>(empType)][day].size(); });
+    if (alternative == nullptr) {
+        return false;
+    }
+
+    for (const auto& [employeeType, employeeTypeCount] : *alternative) {
+        auto& pool = __employees_by_type_and_day[static_cast<int>(employeeType)][day];
+        for (int workers_count = employeeTypeCount; workers_count > 0; workers_count--) {
+            __crews.push_back(__employees[pool.back()].id);
+            pool.pop_back();
+        }
+    }
+    return true;
+}
+
+void CompactScheduler::shrinkToFit() {
+    __employees.shrink_to_fit();
+    for (auto& pools : __employees_by_type_and_day) {
+        for (auto& pool : pools) {
+            pool.shrink_to_fit();
+        }
+    }
+    __buildings.shrink_to_fit();
+    __pending_buildings.shrink_to_fit();
+    for (auto& entries : __daily_schedule) {
+        entries.shrink_to_fit();
+    }
+    __crews.shrink_to_fit();
+}
+
+MemoryUsage CompactScheduler::memoryUsage() const {
+    MemoryUsage usage;
+    usage.employees = heapBytes(__employees) + heapBytes(__employee_slots);
+    for (const auto& pools : __employees_by_type_and_day) {
+        for (const auto& pool : pools) {
+            usage.availabilityPools += heapBytes(pool);
+        }
+    }
+    usage.buildings = heapBytes(__buildings) + heapBytes(__pending_buildings);
+    for (const auto& building : __buildings) {
+        usage.buildings += building.name.heapBytes();
+    }
+    for (const auto& entries : __daily_schedule) {
+        usage.schedule += heapBytes(entries);
+    }
+    usage.schedule += heapBytes(__crews);
+    return usage;
+}
+
+CompactScheduler::Schedule_Type CompactScheduler::getSchedule() const {
+    Schedule_Type schedule;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        schedule[day].reserve(__daily_schedule[day].size());
+        for (const auto& entry : __daily_schedule[day]) {
+            auto crew_begin = __crews.begin() + entry.crewBegin;
+            schedule[day].push_back(make_pair(std::string(__buildings[entry.building].name.view()),
+                                              std::vector<int>(crew_begin, crew_begin + entry.crewSize)));
+        }
+    }
+    return schedule;
+}
+
+void CompactScheduler::printSchedule() const {
+    cout << "************ SCHEDULE ***************" << endl;
+    for (DayOfWeek currDay = DayOfWeek::MONDAY; static_cast<int>(currDay) < WORK_DAYS; ++currDay) {
+        for (const auto& entry : __daily_schedule[static_cast<int>(currDay)]) {
+            cout << dayToStr.at(currDay) << ": ";
+            cout << "Building -> " << __buildings[entry.building].name.view() << ": | Employees -> ";
+            for (uint32_t crew = entry.crewBegin; crew < entry.crewBegin + entry.crewSize; crew++) {
+                cout << "[" << __crews[crew] << "] ";
+            }
+            cout << endl;
+        }
+    }
+    cout << "*************************************" << endl;
+}
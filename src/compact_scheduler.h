@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <array>
+#include <utility>
+#include <cstdint>
+#include "employee.h"
+#include "building.h"
+#include "days.h"
+#include "memory_usage.h"
+#include "small_string.h"
+
+
+// Memory-lean variant of the greedy Scheduler for very large rosters: 32-bit ids and indices, availability as a
+// day bitmask, an open-addressing id lookup instead of a node-based map, small-string building names stored once
+// and a schedule holding building indices and a flat crew array instead of copied names and per-crew vectors.
+// Produces the same schedule as Scheduler with the GREEDY policy.
+class CompactScheduler {
+    public:
+        using Schedule_Type = std::array<std::vector<std::pair<std::string, std::vector<int>>>, WORK_DAYS>;
+
+        CompactScheduler();
+        void schedule();
+        void printSchedule() const;
+        Schedule_Type getSchedule() const; //materialized from the compact storage
+        void updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability);
+        // the same id again replaces the employee, its type and availability included
+        void addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability);
+        void addBuilding(const std::string& buildName, const BuildingType& buildType);
+        void shrinkToFit(); //gives back the spare capacity, e.g. once the roster is loaded
+        MemoryUsage memoryUsage() const;
+
+    private:
+        static constexpr std::uint32_t __EMPTY_SLOT = UINT32_MAX;
+        static_assert(WORK_DAYS <= 8, "availability is kept in one byte");
+
+        struct __CompactEmployee {
+            std::uint32_t id;
+            std::uint8_t type;
+            std::uint8_t availability; //bit per day
+        };
+        struct __CompactBuilding {
+            SmallString name;
+            std::uint8_t type;
+        };
+        struct __ScheduleEntry {
+            std::uint32_t building; //index in __buildings
+            std::uint32_t crewBegin; //offset in __crews
+            std::uint32_t crewSize;
+        };
+
+        std::vector<__CompactEmployee> __employees;
+        std::vector<std::uint32_t> __employee_slots; //open addressing on the id, holds indices in __employees
+        std::array<std::array<std::vector<std::uint32_t>, WORK_DAYS>, EMPLOYEE_TYPES> __employees_by_type_and_day; //indices in __employees
+        std::vector<__CompactBuilding> __buildings;
+        std::vector<std::uint32_t> __pending_buildings; //indices of the buildings not scheduled yet, in insertion order
+        std::array<std::vector<__ScheduleEntry>, WORK_DAYS> __daily_schedule;
+        std::vector<std::uint32_t> __crews; //employee ids of all scheduled crews, back to back
+
+        std::uint32_t __findEmployee(const std::uint32_t& employeeId) const; //index in __employees, __EMPTY_SLOT if unknown
+        void __insertSlot(const std::uint32_t& index);
+        void __growSlots();
+        bool __canBuild(const __CompactBuilding& building, int day);
+};
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "compact_scheduler.h"
+#include "scheduler.h"
+#include "scheduler_invariants.h"
+
+using namespace std;
+
+
+class CompactSchedulerTest : public testing::Test {
+  protected:
+        CompactScheduler scheduler;
+};
+
+
+TEST_F(CompactSchedulerTest, matchesSchedulerOnRandomInputs) {
+    for (unsigned seed = 1; seed <= 20; seed++) {
+        mt19937 rng(seed);
+        Workload workload = randomWorkload(rng, 40, 60, 30, 0.6);
+        //long names land on the heap, short ones stay inline; sparse ids
+        for (size_t b = 0; b < workload.buildings.size(); b++) {
+            workload.buildings[b].name = (b % 3 == 0 ? "Commercial building number " : "B ") + to_string(b);
+        }
+        for (auto& employee : workload.employees) {
+            employee.id *= 7;
+        }
+        for (auto& [employeeId, availability] : workload.availabilityUpdates) {
+            employeeId *= 7;
+        }
+
+        Scheduler reference;
+        CompactScheduler compact;
+        loadWorkload(reference, workload);
+        loadWorkload(compact, workload);
+
+        reference.schedule();
+        compact.schedule();
+        EXPECT_EQ(reference.getSchedule(), compact.getSchedule()) << "seed " << seed;
+    }
+}
+
+TEST_F(CompactSchedulerTest, largeRosterStaysUnder64BytesPerEmployee) {
+    const int employee_count = 100000;
+    for (int id = 1; id <= employee_count; id++) {
+        scheduler.addEmployee(id, static_cast<EmployeeType>(id % EMPLOYEE_TYPES), {true, id % 2 == 0, true, false, id % 3 == 0});
+    }
+    scheduler.shrinkToFit();
+
+    MemoryUsage usage = scheduler.memoryUsage();
+    EXPECT_LT((usage.employees + usage.availabilityPools) / employee_count, 64);
+
+    Scheduler reference;
+    for (int id = 1; id <= 1000; id++) {
+        reference.addEmployee(id, static_cast<EmployeeType>(id % EMPLOYEE_TYPES), {true, id % 2 == 0, true, false, id % 3 == 0});
+    }
+    MemoryUsage reference_usage = reference.memoryUsage();
+    EXPECT_GT(reference_usage.employees, 0);
+    EXPECT_GT(reference_usage.availabilityPools, 0);
+    EXPECT_GT((reference_usage.employees + reference_usage.availabilityPools) / 1000, (usage.employees + usage.availabilityPools) / employee_count);
+}
+
+TEST_F(CompactSchedulerTest, memoryUsageCoversTheSchedule) {
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    scheduler.addBuilding("Build 1", BuildingType::SINGLE_STORY);
+    MemoryUsage before = scheduler.memoryUsage();
+    EXPECT_EQ(0, before.schedule);
+
+    scheduler.schedule();
+    MemoryUsage after = scheduler.memoryUsage();
+    EXPECT_GT(after.schedule, 0);
+    EXPECT_EQ(after.total(), after.employees + after.availabilityPools + after.buildings + after.schedule + after.indices);
+}
+
+TEST_F(CompactSchedulerTest, duplicateEmployeeIdUpdatesTheRecord) {
+    scheduler.addEmployee(5, EmployeeType::LABORER, {true, false, false, false, false});
+    scheduler.addEmployee(5, EmployeeType::CERTIFIED_INSTALLER, {false, true, false, false, false});
+    scheduler.addBuilding("Build 1", BuildingType::SINGLE_STORY);
+    scheduler.schedule();
+
+    auto schedule = scheduler.getSchedule();
+    EXPECT_TRUE(schedule[0].empty());
+    ASSERT_EQ(1, schedule[1].size());
+    EXPECT_EQ(vector<int>({5}), schedule[1][0].second);
+}
+
+TEST_F(CompactSchedulerTest, duplicateEmployeeIdLeavesTheOldTypePools) {
+    // laborer on Monday, then an installer on Tuesday only: no two-story crew can be put together on either day
+    scheduler.addEmployee(5, EmployeeType::LABORER, {true, false, false, false, false});
+    scheduler.addEmployee(5, EmployeeType::CERTIFIED_INSTALLER, {false, true, false, false, false});
+    scheduler.addEmployee(6, EmployeeType::CERTIFIED_INSTALLER, {true, false, false, false, false});
+    scheduler.addBuilding("Build 1", BuildingType::TWO_STORY);
+    scheduler.schedule();
+
+    for (const auto& day : scheduler.getSchedule()) {
+        EXPECT_TRUE(day.empty());
+    }
+}
+
+TEST(SmallStringTest, shortStringsStayInline) {
+    SmallString name("Build 1");
+    EXPECT_TRUE(name.isInline());
+    EXPECT_EQ("Build 1", name.view());
+    EXPECT_EQ(0, name.heapBytes());
+
+    SmallString longest(string(22, 'x'));
+    EXPECT_TRUE(longest.isInline());
+    EXPECT_EQ(22, longest.view().size());
+}
+
+TEST(SmallStringTest, longStringsMoveToTheHeap) {
+    const string text = "A building with a rather long name";
+    SmallString name(text);
+    EXPECT_FALSE(name.isInline());
+    EXPECT_EQ(text, name.view());
+    EXPECT_EQ(text.size(), name.heapBytes());
+
+    SmallString copy(name);
+    EXPECT_EQ(text, copy.view());
+    EXPECT_NE(name.view().data(), copy.view().data());
+
+    SmallString moved(std::move(copy));
+    EXPECT_EQ(text, moved.view());
+
+    copy = moved;
+    EXPECT_EQ(text, copy.view());
+    EXPECT_EQ(24, sizeof(SmallString));
+}
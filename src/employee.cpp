@@ -3,10 +3,48 @@
 
 using namespace std;
 
-Employee::Employee(){};
+SkillSet skillSetOf(initializer_list<Skill> skills) {
+    SkillSet skillSet;
+    for (const Skill& skill : skills) {
+        skillSet.set(static_cast<size_t>(skill));
+    }
+    return skillSet;
+}
+
+SkillSet skillSetOf(const EmployeeType& type) {
+    switch (type) {
+        case EmployeeType::CERTIFIED_INSTALLER:
+            return skillSetOf({Skill::LABOR, Skill::INSTALLATION, Skill::CERTIFICATION});
+        case EmployeeType::INSTALLER_PENDING_CERTIFICATION:
+            return skillSetOf({Skill::LABOR, Skill::INSTALLATION});
+        case EmployeeType::LABORER:
+            return skillSetOf({Skill::LABOR});
+    }
+    return {};
+}
+
+Employee::Employee():
+    location(),
+    assignedHours(0),
+    lastAssignment(-1)
+    {};
 
 Employee::Employee(const int& id, const EmployeeType& type, const vector<bool>& availability):
     id(id),
     type(type),
-    availability(availability)
+    availability(availability),
+    skills(skillSetOf(type)),
+    location(),
+    assignedHours(0),
+    lastAssignment(-1)
+    {}
+
+Employee::Employee(const int& id, const EmployeeType& type, const SkillSet& skills, const vector<bool>& availability):
+    id(id),
+    type(type),
+    availability(availability),
+    skills(skills),
+    location(),
+    assignedHours(0),
+    lastAssignment(-1)
     {}
\ No newline at end of file
@@ -1,5 +1,11 @@
 #pragma once
 #include <vector>
+#include <bitset>
+#include <initializer_list>
+#include "location.h"
+
+constexpr int EMPLOYEE_TYPES=3;
+constexpr int MAX_SKILLS=64;
 
 enum class EmployeeType {
     CERTIFIED_INSTALLER,
@@ -7,11 +13,28 @@ enum class EmployeeType {
     LABORER
 };
 
+// the skills behind the employee types, further skills can use any bit index up to MAX_SKILLS
+enum class Skill {
+    LABOR,
+    INSTALLATION,
+    CERTIFICATION
+};
+
+using SkillSet = std::bitset<MAX_SKILLS>;
+
+SkillSet skillSetOf(std::initializer_list<Skill> skills);
+SkillSet skillSetOf(const EmployeeType& type); //the skills an employee of the given type carries
+
 class Employee {
     public:
         int id;
         EmployeeType type;
         std::vector<bool> availability;
+        SkillSet skills;
+        Location location; //where the employee starts the day
+        int assignedHours; //hours of the shifts assigned in the current schedule
+        long long lastAssignment; //sequence number of the last shift assigned, -1 if none
         Employee();
         Employee(const int& id, const EmployeeType& type, const std::vector<bool>& availability);
+        Employee(const int& id, const EmployeeType& type, const SkillSet& skills, const std::vector<bool>& availability);
 };
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstddef>
+#include "memory_usage.h"
+
+
+// Binary min-heap of integer handles ordered by Key, with a handle -> position index so a key
+// can be changed or an arbitrary handle removed in O(log n).
+template <typename Key>
+class IndexedMinHeap {
+    public:
+        bool empty() const { return __heap.empty(); }
+        std::size_t size() const { return __heap.size(); }
+        bool contains(const int& handle) const { return __position_by_handle.find(handle) != __position_by_handle.end(); }
+        int top() const { return __heap.front().second; }
+        const Key& keyOf(const int& handle) const { return __heap[__position_by_handle.at(handle)].first; }
+        std::size_t heapBytes() const { return ::heapBytes(__heap) + ::heapBytes(__position_by_handle); }
+
+        void push(const int& handle, const Key& key) {
+            __heap.push_back(std::make_pair(key, handle));
+            __position_by_handle[handle] = __heap.size() - 1;
+            __siftUp(__heap.size() - 1);
+        }
+
+        int pop() {
+            int handle = __heap.front().second;
+            erase(handle);
+            return handle;
+        }
+
+        void update(const int& handle, const Key& key) {
+            auto found = __position_by_handle.find(handle);
+            if (found == __position_by_handle.end()) {
+                return;
+            }
+            std::size_t pos = found->second;
+            __heap[pos].first = key;
+            __siftDown(__siftUp(pos));
+        }
+
+        void erase(const int& handle) {
+            auto found = __position_by_handle.find(handle);
+            if (found == __position_by_handle.end()) {
+                return;
+            }
+            std::size_t pos = found->second;
+            __position_by_handle.erase(found);
+            if (pos + 1 != __heap.size()) {
+                __heap[pos] = std::move(__heap.back());
+                __position_by_handle[__heap[pos].second] = pos;
+                __heap.pop_back();
+                __siftDown(__siftUp(pos));
+            } else {
+                __heap.pop_back();
+            }
+        }
+
+    private:
+        std::vector<std::pair<Key, int>> __heap;
+        std::unordered_map<int, std::size_t> __position_by_handle;
+
+        void __swap(std::size_t lhs, std::size_t rhs) {
+            std::swap(__heap[lhs], __heap[rhs]);
+            __position_by_handle[__heap[lhs].second] = lhs;
+            __position_by_handle[__heap[rhs].second] = rhs;
+        }
+
+        std::size_t __siftUp(std::size_t pos) {
+            while (pos > 0) {
+                std::size_t parent = (pos - 1) / 2;
+                if (!(__heap[pos].first < __heap[parent].first)) {
+                    break;
+                }
+                __swap(pos, parent);
+                pos = parent;
+            }
+            return pos;
+        }
+
+        void __siftDown(std::size_t pos) {
+            while (true) {
+                std::size_t smallest = pos;
+                std::size_t left = 2 * pos + 1;
+                std::size_t right = left + 1;
+                if (left < __heap.size() && __heap[left].first < __heap[smallest].first) {
+                    smallest = left;
+                }
+                if (right < __heap.size() && __heap[right].first < __heap[smallest].first) {
+                    smallest = right;
+                }
+                if (smallest == pos) {
+                    return;
+                }
+                __swap(pos, smallest);
+                pos = smallest;
+            }
+        }
+};
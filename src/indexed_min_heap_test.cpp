@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include "indexed_min_heap.h"
+
+using namespace std;
+
+
+TEST(IndexedMinHeapTest, popsInKeyOrder) {
+    IndexedMinHeap<int> heap;
+    heap.push(10, 5);
+    heap.push(11, 1);
+    heap.push(12, 3);
+    heap.push(13, 4);
+
+    EXPECT_EQ(4, heap.size());
+    EXPECT_EQ(11, heap.pop());
+    EXPECT_EQ(12, heap.pop());
+    EXPECT_EQ(13, heap.pop());
+    EXPECT_EQ(10, heap.pop());
+    EXPECT_TRUE(heap.empty());
+}
+
+TEST(IndexedMinHeapTest, updateAndErase) {
+    IndexedMinHeap<int> heap;
+    for (int handle = 0; handle < 8; handle++) {
+        heap.push(handle, handle);
+    }
+
+    heap.update(0, 20);
+    heap.update(7, -1);
+    heap.erase(3);
+    heap.erase(42);
+
+    EXPECT_FALSE(heap.contains(3));
+    EXPECT_EQ(20, heap.keyOf(0));
+    std::vector<int> order;
+    while (!heap.empty()) {
+        order.push_back(heap.pop());
+    }
+    EXPECT_EQ(std::vector<int>({7, 1, 2, 4, 5, 6, 0}), order);
+}
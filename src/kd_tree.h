@@ -0,0 +1,119 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <cstddef>
+#include "location.h"
+#include "memory_usage.h"
+
+
+// Static 2-d tree over (id, Location) points supporting removal, for nearest-neighbour queries on pools that
+// only shrink. Nodes are laid out implicitly: the range [lo, hi) is rooted at its middle element, split on x at
+// even depths and on y at odd depths. Each node counts the live points of its subtree, so removed subtrees are pruned.
+class KdTree {
+    public:
+        KdTree() = default;
+
+        explicit KdTree(std::vector<std::pair<int, Location>> points):
+            __nodes(std::move(points)),
+            __alive(__nodes.size(), 0),
+            __removed(__nodes.size(), false),
+            __position_by_id()
+            {
+                __build(0, __nodes.size(), 0);
+                __position_by_id.reserve(__nodes.size());
+                for (std::size_t pos = 0; pos < __nodes.size(); pos++) {
+                    __position_by_id[__nodes[pos].first] = pos;
+                }
+            }
+
+        std::size_t size() const { return __nodes.empty() ? 0 : __alive[__rootOf(0, __nodes.size())]; }
+        std::size_t heapBytes() const {
+            return ::heapBytes(__nodes) + ::heapBytes(__alive) + ::heapBytes(__removed) + ::heapBytes(__position_by_id);
+        }
+        bool contains(const int& id) const {
+            auto found = __position_by_id.find(id);
+            return found != __position_by_id.end() && !__removed[found->second];
+        }
+
+        // id of the live point nearest to the target, -1 when none is left
+        int nearest(const Location& target) const {
+            int best = -1;
+            double best_distance = std::numeric_limits<double>::infinity();
+            __nearest(0, __nodes.size(), 0, target, best, best_distance);
+            return best;
+        }
+
+        void erase(const int& id) {
+            auto found = __position_by_id.find(id);
+            if (found == __position_by_id.end() || __removed[found->second]) {
+                return;
+            }
+            std::size_t pos = found->second;
+            __removed[pos] = true;
+            // walk down from the root to the node, every subtree on the way loses a live point
+            std::size_t lo = 0, hi = __nodes.size();
+            while (true) {
+                std::size_t mid = __rootOf(lo, hi);
+                __alive[mid]--;
+                if (mid == pos) {
+                    return;
+                }
+                if (pos < mid) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+        }
+
+    private:
+        std::vector<std::pair<int, Location>> __nodes;
+        std::vector<std::size_t> __alive; //live points in the subtree rooted at each node
+        std::vector<bool> __removed;
+        std::unordered_map<int, std::size_t> __position_by_id;
+
+        static std::size_t __rootOf(std::size_t lo, std::size_t hi) { return lo + (hi - lo) / 2; }
+        static double __coordinate(const Location& location, int depth) { return depth % 2 == 0 ? location.x : location.y; }
+
+        void __build(std::size_t lo, std::size_t hi, int depth) {
+            if (lo >= hi) {
+                return;
+            }
+            std::size_t mid = __rootOf(lo, hi);
+            std::nth_element(__nodes.begin() + lo, __nodes.begin() + mid, __nodes.begin() + hi, [depth](const auto& lhs, const auto& rhs) {
+                return __coordinate(lhs.second, depth) < __coordinate(rhs.second, depth);
+            });
+            __alive[mid] = hi - lo;
+            __build(lo, mid, depth + 1);
+            __build(mid + 1, hi, depth + 1);
+        }
+
+        void __nearest(std::size_t lo, std::size_t hi, int depth, const Location& target, int& best, double& best_distance) const {
+            if (lo >= hi) {
+                return;
+            }
+            std::size_t mid = __rootOf(lo, hi);
+            if (__alive[mid] == 0) {
+                return;
+            }
+            const auto& [id, location] = __nodes[mid];
+            if (!__removed[mid]) {
+                double distance = travelDistance(location, target);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best = id;
+                }
+            }
+
+            double split = __coordinate(target, depth) - __coordinate(location, depth);
+            std::pair<std::size_t, std::size_t> near_side = split < 0 ? std::make_pair(lo, mid) : std::make_pair(mid + 1, hi);
+            std::pair<std::size_t, std::size_t> far_side = split < 0 ? std::make_pair(mid + 1, hi) : std::make_pair(lo, mid);
+            __nearest(near_side.first, near_side.second, depth + 1, target, best, best_distance);
+            if (std::abs(split) < best_distance) {
+                __nearest(far_side.first, far_side.second, depth + 1, target, best, best_distance);
+            }
+        }
+};
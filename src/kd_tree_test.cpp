@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "kd_tree.h"
+
+using namespace std;
+
+
+TEST(KdTreeTest, emptyTree) {
+    KdTree tree;
+    EXPECT_EQ(0, tree.size());
+    EXPECT_EQ(-1, tree.nearest({0, 0}));
+    EXPECT_FALSE(tree.contains(1));
+}
+
+TEST(KdTreeTest, nearestMatchesBruteForceWhileErasing) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> coordinate_dist(0.0, 100.0);
+    std::vector<std::pair<int, Location>> points;
+    for (int id = 0; id < 500; id++) {
+        points.push_back(make_pair(id, Location{coordinate_dist(rng), coordinate_dist(rng)}));
+    }
+
+    KdTree tree(points);
+    std::vector<bool> removed(points.size(), false);
+    for (int query = 0; query < 500; query++) {
+        Location target = {coordinate_dist(rng), coordinate_dist(rng)};
+        double best_distance = std::numeric_limits<double>::infinity();
+        for (const auto& [id, location] : points) {
+            if (!removed[id]) {
+                best_distance = std::min(best_distance, travelDistance(location, target));
+            }
+        }
+
+        int nearest = tree.nearest(target);
+        ASSERT_NE(-1, nearest);
+        EXPECT_DOUBLE_EQ(best_distance, travelDistance(points[nearest].second, target));
+        // take the found point out, like an employee assigned to a building
+        tree.erase(nearest);
+        removed[nearest] = true;
+        EXPECT_FALSE(tree.contains(nearest));
+        EXPECT_EQ(points.size() - query - 1, tree.size());
+    }
+    EXPECT_EQ(-1, tree.nearest({50, 50}));
+}
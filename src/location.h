@@ -0,0 +1,12 @@
+#pragma once
+#include <cmath>
+
+// position on the city map, in km on a local planar projection
+struct Location {
+    double x;
+    double y;
+};
+
+inline double travelDistance(const Location& from, const Location& to) {
+    return std::hypot(from.x - to.x, from.y - to.y);
+}
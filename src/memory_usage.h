@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+
+// bytes held by a scheduler, split by internal structure. Sizes are estimates: container footprints and their
+// heap allocations are counted, hash nodes and buckets included, allocator overhead per allocation and the
+// block map of a deque are not.
+struct MemoryUsage {
+    std::size_t employees = 0;         //employee records and the id lookup
+    std::size_t availabilityPools = 0; //available employees by type and day
+    std::size_t buildings = 0;         //buildings waiting to be scheduled
+    std::size_t schedule = 0;          //scheduled buildings and their crews
+    std::size_t indices = 0;           //lookup indices and policy structures
+    std::size_t diagnostics = 0;       //shortfalls of the buildings tried and the capacity report
+
+    std::size_t total() const {
+        return employees + availabilityPools + buildings + schedule + indices + diagnostics;
+    }
+};
+
+template <typename T>
+std::size_t heapBytes(const std::vector<T>& values) {
+    return values.capacity() * sizeof(T);
+}
+
+inline std::size_t heapBytes(const std::vector<bool>& values) {
+    return (values.capacity() + 63) / 64 * sizeof(std::uint64_t);
+}
+
+inline std::size_t heapBytes(const std::string& text) {
+    //libstdc++ and libc++ keep short strings inline in the object
+    return text.capacity() > 15 ? text.capacity() + 1 : 0;
+}
+
+// bucket array plus one node per element (next pointer and the value, plus the hash when it is cached)
+template <typename K, typename V, typename H, typename E, typename A>
+std::size_t heapBytes(const std::unordered_map<K, V, H, E, A>& map) {
+    return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(void*) + sizeof(std::pair<const K, V>) + sizeof(std::size_t));
+}
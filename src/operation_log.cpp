@@ -0,0 +1,348 @@
+#include <stdexcept>
+#include <cstring>
+#include <memory>
+#include <deque>
+#include <functional>
+#include <stop_token>
+#include <map>
+#include <filesystem>
+
+#include "operation_log.h"
+
+using namespace std;
+
+namespace {
+constexpr char LOG_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'L', 'O', 'G'};
+static_assert(WORK_DAYS <= 8, "availability is logged as one byte");
+
+// runs the buildings tried in one chunk, then cancels like the logged run was
+void replayPartialSchedule(Scheduler& scheduler, size_t buildingsTried) {
+    deque<function<void()>> tasks;
+    stop_source stop;
+    auto result = scheduler.scheduleAsync([&](function<void()> task) { tasks.push_back(std::move(task)); }, stop.get_token(),
+                                          [&](const ScheduleProgress&) { stop.request_stop(); }, buildingsTried);
+    while (!tasks.empty()) {
+        function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        task();
+    }
+    result.get();
+}
+
+class LogReader {
+    public:
+        LogReader(FILE* file, size_t size):
+            __file(file),
+            __remaining(size)
+            {}
+
+        bool atEnd() {
+            int c = fgetc(__file);
+            if (c == EOF) {
+                return true;
+            }
+            ungetc(c, __file);
+            return false;
+        }
+
+        void get(void* bytes, size_t count) {
+            if (fread(bytes, 1, count, __file) != count) {
+                throw runtime_error("operation log is truncated");
+            }
+            __remaining -= count;
+        }
+
+        int32_t getInt() {
+            int32_t value;
+            get(&value, sizeof(value));
+            return value;
+        }
+
+        uint8_t getByte() {
+            uint8_t value;
+            get(&value, sizeof(value));
+            return value;
+        }
+
+        template <typename Enum>
+        Enum getEnum(int count) {
+            int32_t value = getInt();
+            if (value < 0 || value >= count) {
+                throw runtime_error("operation log has an invalid type");
+            }
+            return static_cast<Enum>(value);
+        }
+
+        size_t getCount() {
+            int32_t count = getInt();
+            if (count < 0) {
+                throw runtime_error("operation log has a negative length");
+            }
+            return static_cast<size_t>(count);
+        }
+
+        // length of what follows, checked against the bytes left so a corrupt length fails before anything is allocated
+        size_t getLength(size_t elementBytes = 1) {
+            size_t length = getCount();
+            if (length > __remaining / elementBytes) {
+                throw runtime_error("operation log has an invalid length");
+            }
+            return length;
+        }
+
+        shared_ptr<const Scheduler::BuildingRequrement_Type> getBuildingRequirements() {
+            int32_t type_count = getInt();
+            if (type_count == -1) {
+                return nullptr; //the default table
+            }
+            if (type_count < 0 || static_cast<size_t>(type_count) > __remaining / (2 * sizeof(int32_t))) {
+                throw runtime_error("operation log has an invalid length");
+            }
+            auto requirements = make_shared<Scheduler::BuildingRequrement_Type>();
+            for (int32_t t = 0; t < type_count; t++) {
+                auto& alternatives = (*requirements)[getEnum<BuildingType>(BUILDING_TYPES)];
+                alternatives.resize(getLength(sizeof(int32_t))); //each alternative starts with its length
+                for (auto& alternative : alternatives) {
+                    alternative.resize(getLength(2 * sizeof(int32_t))); //type and count of each entry
+                    for (auto& [empType, count] : alternative) {
+                        empType = getEnum<EmployeeType>(EMPLOYEE_TYPES);
+                        count = getInt();
+                    }
+                }
+            }
+            return requirements;
+        }
+
+        Location getLocation() {
+            Location location;
+            get(&location.x, sizeof(location.x));
+            get(&location.y, sizeof(location.y));
+            return location;
+        }
+
+        vector<bool> getAvailability() {
+            uint8_t bits = getByte();
+            vector<bool> availability(WORK_DAYS);
+            for (int day = 0; day < WORK_DAYS; day++) {
+                availability[day] = (bits >> day) & 1;
+            }
+            return availability;
+        }
+
+    private:
+        FILE* __file;
+        size_t __remaining; //bytes of the file not read yet
+};
+}
+
+OperationLog::OperationLog(const std::string& path):
+    __file(fopen(path.c_str(), "ab")),
+    __buffer()
+    {
+        if (__file == nullptr) {
+            throw runtime_error("can't open operation log " + path);
+        }
+        setvbuf(__file, nullptr, _IONBF, 0); //the records are buffered in __buffer already
+        __buffer.reserve(BUFFER_BYTES);
+        if (ftell(__file) == 0) {
+            __put(LOG_MAGIC, sizeof(LOG_MAGIC));
+        }
+    }
+
+OperationLog::~OperationLog() {
+    try {
+        flush();
+    } catch (const runtime_error&) {
+        //nothing left to report the error to, the records still buffered are lost
+    }
+    fclose(__file);
+}
+
+void OperationLog::flush() {
+    if (!__buffer.empty()) {
+        size_t written = fwrite(__buffer.data(), 1, __buffer.size(), __file);
+        //the records written are dropped from the buffer either way, so a later flush doesn't write them twice
+        __buffer.erase(__buffer.begin(), __buffer.begin() + written);
+        if (!__buffer.empty()) {
+            throw runtime_error("can't write the operation log");
+        }
+    }
+}
+
+void OperationLog::__put(const void* bytes, std::size_t count) {
+    if (__buffer.size() + count > BUFFER_BYTES) {
+        flush();
+    }
+    const char* chars = static_cast<const char*>(bytes);
+    __buffer.insert(__buffer.end(), chars, chars + count);
+}
+
+void OperationLog::__putOperation(const Operation& op) {
+    uint8_t code = static_cast<uint8_t>(op);
+    __put(&code, sizeof(code));
+}
+
+void OperationLog::__putInt(const std::int32_t& value) {
+    __put(&value, sizeof(value));
+}
+
+void OperationLog::__putAvailability(const std::vector<bool>& availability) {
+    uint8_t bits = 0;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        bits |= static_cast<uint8_t>(availability[day]) << day;
+    }
+    __put(&bits, sizeof(bits));
+}
+
+void OperationLog::__putLocation(const Location& location) {
+    __put(&location.x, sizeof(location.x));
+    __put(&location.y, sizeof(location.y));
+}
+
+void OperationLog::recordAddEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability, const Location& empLocation) {
+    __putOperation(Operation::ADD_EMPLOYEE);
+    __putInt(employeeId);
+    __putInt(static_cast<int32_t>(empType));
+    __putAvailability(empAvailability);
+    __putLocation(empLocation);
+}
+
+void OperationLog::recordAddBuilding(const std::string& buildName, const BuildingType& buildType, const Location& buildLocation) {
+    __putOperation(Operation::ADD_BUILDING);
+    __putInt(static_cast<int32_t>(buildType));
+    __putLocation(buildLocation);
+    __putInt(static_cast<int32_t>(buildName.size()));
+    __put(buildName.data(), buildName.size());
+}
+
+void OperationLog::recordUpdateAvailability(const int& employeeId, const std::vector<bool>& newAvailability) {
+    __putOperation(Operation::UPDATE_AVAILABILITY);
+    __putInt(employeeId);
+    __putAvailability(newAvailability);
+}
+
+void OperationLog::recordSchedule() {
+    __putOperation(Operation::SCHEDULE);
+    flush();
+}
+
+void OperationLog::recordPartialSchedule(const std::size_t& buildingsTried) {
+    __putOperation(Operation::SCHEDULE_PARTIAL);
+    __putInt(static_cast<int32_t>(buildingsTried));
+    flush();
+}
+
+void OperationLog::recordAssignmentPolicy(const AssignmentPolicy& policy) {
+    __putOperation(Operation::SET_ASSIGNMENT_POLICY);
+    __putInt(static_cast<int32_t>(policy));
+}
+
+void OperationLog::recordWeeklyHourCap(const int& hours) {
+    __putOperation(Operation::SET_WEEKLY_HOUR_CAP);
+    __putInt(hours);
+}
+
+void OperationLog::recordStartWeek() {
+    __putOperation(Operation::START_WEEK);
+}
+
+void OperationLog::recordBuildingRequirements(const Scheduler::BuildingRequrement_Type* requirements) {
+    __putOperation(Operation::SET_BUILDING_REQUIREMENTS);
+    if (requirements == nullptr) {
+        __putInt(-1);
+        return;
+    }
+    // by building type so equal tables log the same bytes, the alternatives keep their order
+    map<BuildingType, const vector<Scheduler::RequirementAlternative_Type>*> by_type;
+    for (const auto& [buildType, alternatives] : *requirements) {
+        by_type[buildType] = &alternatives;
+    }
+    __putInt(static_cast<int32_t>(by_type.size()));
+    for (const auto& [buildType, alternatives] : by_type) {
+        __putInt(static_cast<int32_t>(buildType));
+        __putInt(static_cast<int32_t>(alternatives->size()));
+        for (const auto& alternative : *alternatives) {
+            __putInt(static_cast<int32_t>(alternative.size()));
+            for (const auto& [empType, count] : alternative) {
+                __putInt(static_cast<int32_t>(empType));
+                __putInt(count);
+            }
+        }
+    }
+}
+
+void OperationLog::recordLoadSnapshot(std::string_view bytes) {
+    __putOperation(Operation::LOAD_SNAPSHOT);
+    __putInt(static_cast<int32_t>(bytes.size()));
+    __put(bytes.data(), bytes.size());
+}
+
+std::size_t replayOperationLog(const std::string& path, Scheduler& scheduler) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw runtime_error("can't open operation log " + path);
+    }
+    unique_ptr<FILE, int (*)(FILE*)> closer(file, fclose);
+    setvbuf(file, nullptr, _IOFBF, OperationLog::BUFFER_BYTES);
+    LogReader reader(file, filesystem::file_size(path));
+
+    char magic[sizeof(LOG_MAGIC)];
+    reader.get(magic, sizeof(magic));
+    if (memcmp(magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0) {
+        throw runtime_error(path + " is not an operation log");
+    }
+
+    size_t replayed = 0;
+    while (!reader.atEnd()) {
+        switch (static_cast<Operation>(reader.getByte())) {
+            case Operation::ADD_EMPLOYEE: {
+                int employeeId = reader.getInt();
+                EmployeeType empType = reader.getEnum<EmployeeType>(EMPLOYEE_TYPES);
+                vector<bool> empAvailability = reader.getAvailability();
+                scheduler.addEmployee(employeeId, empType, empAvailability, reader.getLocation());
+                break;
+            }
+            case Operation::ADD_BUILDING: {
+                BuildingType buildType = reader.getEnum<BuildingType>(BUILDING_TYPES);
+                Location buildLocation = reader.getLocation();
+                string buildName(reader.getLength(), '\0');
+                reader.get(buildName.data(), buildName.size());
+                scheduler.addBuilding(buildName, buildType, buildLocation);
+                break;
+            }
+            case Operation::UPDATE_AVAILABILITY: {
+                int employeeId = reader.getInt();
+                scheduler.updateAvailability(employeeId, reader.getAvailability());
+                break;
+            }
+            case Operation::SCHEDULE:
+                scheduler.schedule();
+                break;
+            case Operation::SET_ASSIGNMENT_POLICY:
+                scheduler.setAssignmentPolicy(reader.getEnum<AssignmentPolicy>(static_cast<int>(AssignmentPolicy::NEAREST) + 1));
+                break;
+            case Operation::SET_WEEKLY_HOUR_CAP:
+                scheduler.setWeeklyHourCap(reader.getInt());
+                break;
+            case Operation::START_WEEK:
+                scheduler.startWeek();
+                break;
+            case Operation::SCHEDULE_PARTIAL:
+                replayPartialSchedule(scheduler, reader.getCount());
+                break;
+            case Operation::SET_BUILDING_REQUIREMENTS:
+                scheduler.setBuildingRequirements(reader.getBuildingRequirements());
+                break;
+            case Operation::LOAD_SNAPSHOT: {
+                string bytes(reader.getLength(), '\0');
+                reader.get(bytes.data(), bytes.size());
+                scheduler.loadSnapshot(bytes);
+                break;
+            }
+            default:
+                throw runtime_error("unknown operation in " + path);
+        }
+        replayed++;
+    }
+    return replayed;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include "scheduler.h"
+
+enum class Operation : std::uint8_t {
+    ADD_EMPLOYEE,
+    ADD_BUILDING,
+    UPDATE_AVAILABILITY,
+    SCHEDULE,
+    SET_ASSIGNMENT_POLICY,
+    SET_WEEKLY_HOUR_CAP,
+    START_WEEK,
+    SCHEDULE_PARTIAL, //a scheduleAsync run cancelled after trying the given number of buildings
+    SET_BUILDING_REQUIREMENTS,
+    LOAD_SNAPSHOT
+};
+
+// Append-only binary log of the calls made on a Scheduler, see Scheduler::setOperationLog.
+// Records are packed in a memory buffer and written with a single fwrite when it fills up, after each
+// schedule() and on destruction. Integers are stored in native byte order, availability as a day bitmask.
+class OperationLog {
+    public:
+        static constexpr std::size_t BUFFER_BYTES = 64 * 1024;
+
+        explicit OperationLog(const std::string& path); //appends to the file, throws std::runtime_error if it can't be opened
+        ~OperationLog();
+        OperationLog(const OperationLog&) = delete;
+        OperationLog& operator=(const OperationLog&) = delete;
+
+        void recordAddEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability, const Location& empLocation);
+        void recordAddBuilding(const std::string& buildName, const BuildingType& buildType, const Location& buildLocation);
+        void recordUpdateAvailability(const int& employeeId, const std::vector<bool>& newAvailability);
+        void recordSchedule();
+        void recordPartialSchedule(const std::size_t& buildingsTried);
+        void recordAssignmentPolicy(const AssignmentPolicy& policy);
+        void recordWeeklyHourCap(const int& hours);
+        void recordStartWeek();
+        void recordBuildingRequirements(const Scheduler::BuildingRequrement_Type* requirements); //nullptr for the default table
+        void recordLoadSnapshot(std::string_view bytes);
+        void flush(); //throws std::runtime_error if the buffered records can't be written, the unwritten ones are kept
+
+    private:
+        std::FILE* __file;
+        std::vector<char> __buffer;
+
+        void __put(const void* bytes, std::size_t count);
+        void __putOperation(const Operation& op);
+        void __putInt(const std::int32_t& value);
+        void __putAvailability(const std::vector<bool>& availability);
+        void __putLocation(const Location& location);
+};
+
+// Rebuilds the scheduler state by re-issuing every logged call on the given scheduler, schedule() included;
+// a cancelled scheduleAsync run is re-run up to the building it stopped at.
+// Returns the number of operations replayed, throws std::runtime_error on a missing or corrupt log.
+std::size_t replayOperationLog(const std::string& path, Scheduler& scheduler);
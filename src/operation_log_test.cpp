@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <memory>
+#include <deque>
+#include <functional>
+#include <stop_token>
+#include <cstdint>
+#include "operation_log.h"
+
+using namespace std;
+
+
+class OperationLogTest : public testing::Test {
+  protected:
+        std::string path;
+
+    OperationLogTest() {
+        path = (std::filesystem::path(testing::TempDir()) /
+                (std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + ".log")).string();
+        std::filesystem::remove(path);
+    }
+
+    ~OperationLogTest() override {
+        std::filesystem::remove(path);
+    }
+};
+
+
+TEST_F(OperationLogTest, replayRebuildsSchedule) {
+    Scheduler scheduler;
+    {
+        OperationLog log(path);
+        scheduler.setOperationLog(&log);
+
+        scheduler.addBuilding("Build 0", BuildingType::TWO_STORY);
+        scheduler.addBuilding("Build 1", BuildingType::COMMERCIAL);
+        scheduler.addBuilding("Build 2", BuildingType::SINGLE_STORY);
+        scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+        scheduler.addEmployee(2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, false, true});
+        scheduler.addEmployee(3, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, false, true, false});
+        scheduler.addEmployee(4, EmployeeType::LABORER, {true, true, true, false, false});
+        scheduler.addEmployee(5, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}, {3.0, 4.0});
+        scheduler.updateAvailability(1, {false, true, true, true, true});
+        scheduler.setAssignmentPolicy(AssignmentPolicy::ROUND_ROBIN);
+        scheduler.setWeeklyHourCap(2 * SHIFT_HOURS);
+        scheduler.schedule();
+        scheduler.startWeek();
+        scheduler.addBuilding("Build 3", BuildingType::SINGLE_STORY, {2.5, 4.5});
+        scheduler.updateAvailability(2, {true, true, true, true, true});
+        scheduler.setAssignmentPolicy(AssignmentPolicy::NEAREST);
+        scheduler.schedule();
+
+        scheduler.setOperationLog(nullptr);
+        scheduler.addBuilding("Build 4", BuildingType::SINGLE_STORY); //not logged
+    }
+
+    Scheduler replayed;
+    EXPECT_EQ(17, replayOperationLog(path, replayed));
+    replayed.printSchedule();
+    EXPECT_EQ(scheduler.getSchedule(), replayed.getSchedule());
+    EXPECT_EQ(scheduler.getAssignedHours(2), replayed.getAssignedHours(2));
+    EXPECT_DOUBLE_EQ(scheduler.getTravelDistance(), replayed.getTravelDistance());
+}
+
+TEST_F(OperationLogTest, appendsAcrossSessions) {
+    Scheduler scheduler;
+    {
+        OperationLog log(path);
+        scheduler.setOperationLog(&log);
+        scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    }
+    {
+        OperationLog log(path);
+        scheduler.setOperationLog(&log);
+        scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+        scheduler.schedule();
+        scheduler.setOperationLog(nullptr);
+    }
+
+    // the second session starts with a snapshot of the employee added in the first one
+    Scheduler replayed;
+    EXPECT_EQ(4, replayOperationLog(path, replayed));
+    EXPECT_EQ(scheduler.getSchedule(), replayed.getSchedule());
+}
+
+TEST_F(OperationLogTest, attachedToLoadedSchedulerRecordsItsState) {
+    Scheduler scheduler;
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}, {1.0, 2.0});
+    scheduler.addEmployee(2, EmployeeType::LABORER, {true, false, true, false, true});
+    scheduler.setAssignmentPolicy(AssignmentPolicy::LEAST_ASSIGNED);
+    auto rules = std::make_shared<Scheduler::BuildingRequrement_Type>();
+    (*rules)[BuildingType::SINGLE_STORY].push_back({{EmployeeType::LABORER, 1}});
+    scheduler.setBuildingRequirements(rules);
+    {
+        OperationLog log(path);
+        scheduler.setOperationLog(&log);
+        scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+        scheduler.addBuilding("Build 1", BuildingType::SINGLE_STORY);
+        scheduler.schedule();
+        scheduler.setOperationLog(nullptr);
+    }
+
+    // rules, snapshot, two buildings and the run
+    Scheduler replayed;
+    EXPECT_EQ(5, replayOperationLog(path, replayed));
+    EXPECT_EQ(scheduler.getSchedule(), replayed.getSchedule());
+    EXPECT_EQ(scheduler.getAssignedHours(2), replayed.getAssignedHours(2));
+    EXPECT_DOUBLE_EQ(scheduler.getTravelDistance(), replayed.getTravelDistance());
+
+    // a log attached to a new scheduler records nothing up front
+    std::filesystem::remove(path);
+    {
+        OperationLog log(path);
+        Scheduler empty;
+        empty.setOperationLog(&log);
+        empty.setOperationLog(nullptr);
+    }
+    Scheduler nothing;
+    EXPECT_EQ(0, replayOperationLog(path, nothing));
+}
+
+TEST_F(OperationLogTest, largeLogSpansBufferFlushes) {
+    Scheduler scheduler;
+    std::mt19937 rng(11);
+    std::bernoulli_distribution avail_dist(0.6);
+    {
+        OperationLog log(path);
+        scheduler.setOperationLog(&log);
+        for (int b = 0; b < 5000; b++) {
+            scheduler.addBuilding("A building with a name longer than the small string buffer " + std::to_string(b),
+                                  static_cast<BuildingType>(b % BUILDING_TYPES));
+        }
+        for (int id = 1; id <= 2000; id++) {
+            std::vector<bool> availability(WORK_DAYS);
+            for (int day = 0; day < WORK_DAYS; day++) {
+                availability[day] = avail_dist(rng);
+            }
+            scheduler.addEmployee(id, static_cast<EmployeeType>(id % EMPLOYEE_TYPES), availability);
+        }
+        scheduler.schedule();
+        scheduler.setOperationLog(nullptr);
+    }
+
+    EXPECT_GT(std::filesystem::file_size(path), OperationLog::BUFFER_BYTES);
+    Scheduler replayed;
+    EXPECT_EQ(7001, replayOperationLog(path, replayed));
+    EXPECT_EQ(scheduler.getSchedule(), replayed.getSchedule());
+}
+
+TEST_F(OperationLogTest, corruptLogThrows) {
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a log";
+    }
+    Scheduler replayed;
+    EXPECT_THROW(replayOperationLog(path, replayed), std::runtime_error);
+    EXPECT_THROW(replayOperationLog(path + ".missing", replayed), std::runtime_error);
+
+    {
+        OperationLog log(path + ".truncated");
+        log.recordAddBuilding("Build 0", BuildingType::SINGLE_STORY, {1.5, 2.5});
+    }
+    std::filesystem::resize_file(path + ".truncated", std::filesystem::file_size(path + ".truncated") - 2);
+    EXPECT_THROW(replayOperationLog(path + ".truncated", replayed), std::runtime_error);
+    std::filesystem::remove(path + ".truncated");
+}
+
+TEST_F(OperationLogTest, invalidFieldsThrow) {
+    {
+        OperationLog log(path + ".type");
+        log.recordAddEmployee(1, static_cast<EmployeeType>(EMPLOYEE_TYPES), {true, true, true, true, true}, {});
+    }
+    {
+        OperationLog log(path + ".policy");
+        log.recordAssignmentPolicy(static_cast<AssignmentPolicy>(-1));
+    }
+    {
+        OperationLog log(path + ".length");
+        log.recordAddBuilding("Build 0", BuildingType::SINGLE_STORY, {});
+    }
+    {
+        // the name length sits right before the name, the last field of the record
+        std::fstream patch(path + ".length", std::ios::binary | std::ios::in | std::ios::out);
+        patch.seekp(std::filesystem::file_size(path + ".length") - std::string("Build 0").size() - sizeof(std::int32_t));
+        std::int32_t negative = -1;
+        patch.write(reinterpret_cast<const char*>(&negative), sizeof(negative));
+    }
+    {
+        OperationLog log(path + ".huge");
+        log.recordAddBuilding("Build 0", BuildingType::SINGLE_STORY, {});
+    }
+    {
+        // a length far past the end of the file fails before the name is allocated
+        std::fstream patch(path + ".huge", std::ios::binary | std::ios::in | std::ios::out);
+        patch.seekp(std::filesystem::file_size(path + ".huge") - std::string("Build 0").size() - sizeof(std::int32_t));
+        std::int32_t huge = INT32_MAX;
+        patch.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    }
+    {
+        OperationLog log(path + ".rules");
+        log.recordBuildingRequirements(&Scheduler::buildingRequirements);
+    }
+    {
+        // the alternatives count of the first building type, after the magic, the operation, the type count and the type
+        std::fstream patch(path + ".rules", std::ios::binary | std::ios::in | std::ios::out);
+        patch.seekp(8 + 1 + 2 * sizeof(std::int32_t));
+        std::int32_t huge = INT32_MAX;
+        patch.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    }
+
+    for (const char* suffix : {".type", ".policy", ".length", ".huge", ".rules"}) {
+        Scheduler replayed;
+        EXPECT_THROW(replayOperationLog(path + suffix, replayed), std::runtime_error) << suffix;
+        std::filesystem::remove(path + suffix);
+    }
+}
+
+TEST_F(OperationLogTest, failedWriteThrows) {
+    if (!std::filesystem::exists("/dev/full")) {
+        GTEST_SKIP() << "needs /dev/full to make the writes fail";
+    }
+    OperationLog log("/dev/full");
+    log.recordAddBuilding("Build 0", BuildingType::SINGLE_STORY, {});
+    EXPECT_THROW(log.flush(), std::runtime_error);
+    EXPECT_THROW(log.recordSchedule(), std::runtime_error);
+}
+
+TEST_F(OperationLogTest, cancelledRunReplaysAsFarAsItGot) {
+    Scheduler scheduler;
+    {
+        OperationLog log(path);
+        scheduler.setOperationLog(&log);
+        for (int b = 0; b < 12; b++) {
+            scheduler.addBuilding("Build " + std::to_string(b), static_cast<BuildingType>(b % BUILDING_TYPES));
+        }
+        for (int id = 1; id <= 10; id++) {
+            scheduler.addEmployee(id, static_cast<EmployeeType>(id % EMPLOYEE_TYPES), {true, id % 2 == 0, true, true, false});
+        }
+
+        // stopped after the third chunk of 5 buildings, in the middle of tuesday
+        std::deque<std::function<void()>> tasks;
+        std::stop_source stop;
+        int chunks = 0;
+        auto result = scheduler.scheduleAsync([&](std::function<void()> task) { tasks.push_back(std::move(task)); }, stop.get_token(),
+                                              [&](const ScheduleProgress&) {
+                                                  if (++chunks == 3) {
+                                                      stop.request_stop();
+                                                  }
+                                              }, 5);
+        while (!tasks.empty()) {
+            std::function<void()> task = std::move(tasks.front());
+            tasks.pop_front();
+            task();
+        }
+        ASSERT_EQ(ScheduleStatus::CANCELLED, result.get());
+        scheduler.setOperationLog(nullptr);
+    }
+
+    Scheduler replayed;
+    EXPECT_EQ(23, replayOperationLog(path, replayed));
+    EXPECT_EQ(scheduler.getSchedule(), replayed.getSchedule());
+
+    EXPECT_TRUE(replayed.getSchedule()[3].empty());
+
+    // the buildings the cancelled run didn't reach are still pending on both
+    scheduler.schedule();
+    replayed.schedule();
+    EXPECT_EQ(scheduler.getSchedule(), replayed.getSchedule());
+    EXPECT_FALSE(replayed.getSchedule()[3].empty());
+}
+
+TEST_F(OperationLogTest, rulesAndSnapshotLoadsAreReplayed) {
+    Scheduler other;
+    other.addBuilding("Loaded 0", BuildingType::SINGLE_STORY);
+    other.addEmployee(7, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    other.addEmployee(8, EmployeeType::LABORER, {true, true, true, true, true});
+    std::string snapshot = other.saveSnapshot();
+
+    Scheduler scheduler;
+    {
+        OperationLog log(path);
+        scheduler.setOperationLog(&log);
+        auto laborOnly = std::make_shared<Scheduler::BuildingRequrement_Type>(Scheduler::BuildingRequrement_Type{
+            {BuildingType::SINGLE_STORY, {{{EmployeeType::LABORER, 1}}, {{EmployeeType::CERTIFIED_INSTALLER, 2}}}}
+        });
+        scheduler.setBuildingRequirements(laborOnly);
+        scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+        scheduler.addBuilding("Build 1", BuildingType::TWO_STORY);
+        scheduler.addEmployee(1, EmployeeType::LABORER, {true, false, false, false, false});
+        scheduler.schedule();
+        EXPECT_THROW(scheduler.loadSnapshot("not a snapshot"), std::runtime_error);
+        scheduler.loadSnapshot(snapshot);
+        scheduler.schedule();
+        scheduler.setBuildingRequirements(nullptr);
+        scheduler.addBuilding("Build 2", BuildingType::TWO_STORY);
+        scheduler.schedule();
+        scheduler.setOperationLog(nullptr);
+    }
+
+    Scheduler replayed;
+    EXPECT_EQ(10, replayOperationLog(path, replayed));
+    EXPECT_EQ(scheduler.getSchedule(), replayed.getSchedule());
+    EXPECT_EQ(scheduler.saveSnapshot(), replayed.saveSnapshot());
+}
@@ -0,0 +1,35 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include "operation_log.h"
+
+// rebuilds a scheduler from an operation log and re-runs it, e.g. to reproduce a production schedule:
+//   scheduler_replay <log> [repeat]
+// with a repeat count the replay is timed and doubles as a benchmark on a recorded workload
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <operation log> [repeat]" << std::endl;
+        return 1;
+    }
+    const std::string path = argv[1];
+    const int repeat = argc > 2 ? std::stoi(argv[2]) : 1;
+
+    try {
+        std::size_t operations = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int run = 0; run < repeat; run++) {
+            Scheduler scheduler;
+            operations = replayOperationLog(path, scheduler);
+            if (run + 1 == repeat) {
+                auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+                scheduler.printSchedule();
+                std::cout << operations << " operations replayed " << repeat << " time(s), "
+                          << elapsed.count() / repeat << " ms per replay" << std::endl;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
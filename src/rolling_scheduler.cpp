@@ -0,0 +1,152 @@
+#include <iostream>
+#include <algorithm>
+
+#include "rolling_scheduler.h"
+
+using namespace std;
+
+RollingScheduler::RollingScheduler():
+    __days(),
+    __today_slot(0),
+    __today(0),
+    __arrivals(0),
+    __employee_types_by_id(),
+    __backlog(),
+    __building_requirements(&Scheduler::buildingRequirements, [](const Scheduler::BuildingRequrement_Type*) {}) //static, not owned
+    {}
+
+void RollingScheduler::setBuildingRequirements(std::shared_ptr<const Scheduler::BuildingRequrement_Type> requirements) {
+    if (!requirements) {
+        requirements = std::shared_ptr<const Scheduler::BuildingRequrement_Type>(&Scheduler::buildingRequirements,
+                                                                                [](const Scheduler::BuildingRequrement_Type*) {});
+    }
+    __building_requirements = std::move(requirements);
+}
+
+
+RollingScheduler::__Day& RollingScheduler::__dayAt(int offset) {
+    return __days[(__today_slot + offset) % HORIZON_DAYS];
+}
+
+const RollingScheduler::__Day& RollingScheduler::__dayAt(int offset) const {
+    return __days[(__today_slot + offset) % HORIZON_DAYS];
+}
+
+void RollingScheduler::addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability) {
+    __employee_types_by_id[employeeId] = empType;
+    for (int offset = 0; offset < HORIZON_DAYS; offset++) {
+        if (empAvailability[offset]) {
+            __dayAt(offset).available[static_cast<int>(empType)].push_back(employeeId);
+        }
+    }
+}
+
+void RollingScheduler::updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability) {
+    int type = static_cast<int>(__employee_types_by_id.at(employeeId));
+    for (int offset = 0; offset < HORIZON_DAYS; offset++) {
+        __Day& day = __dayAt(offset);
+        if (day.assigned.contains(employeeId)) {
+            continue; //already booked that day, the crew keeps them
+        }
+        auto& pool = day.available[type];
+        auto was_available_already = find(pool.begin(), pool.end(), employeeId);
+        if (newAvailability[offset]) {
+            if (was_available_already == pool.end()) {
+                pool.push_back(employeeId);
+            }
+        } else if (was_available_already != pool.end()) {
+            pool.erase(was_available_already);
+        }
+    }
+}
+
+void RollingScheduler::addBuilding(const std::string& buildName, const BuildingType& buildType, const int& priority) {
+    __BacklogKey_Type key = make_tuple(-(priority - BACKLOG_AGING_PER_DAY * __today), __arrivals++);
+    __backlog.emplace(key, __BacklogEntry{Building(buildName, buildType), priority, __today});
+}
+
+void RollingScheduler::schedule() {
+    for (int offset = 0; offset < HORIZON_DAYS; offset++) {
+        __Day& day = __dayAt(offset);
+        for (auto it = __backlog.begin(); it != __backlog.end(); ) {
+            std::vector<int> assignedEmployees;
+
+            if (__canBuild(it->second.building, day, assignedEmployees)) {
+                day.schedule.push_back(make_pair(it->second.building.name, std::move(assignedEmployees)));
+                it = __backlog.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+RollingScheduler::DaySchedule_Type RollingScheduler::advanceDay(const std::vector<int>& availableEmployeeIds) {
+    // the ids are resolved first, an unknown one throws before today is closed
+    std::array<std::vector<int>, EMPLOYEE_TYPES> admitted;
+    for (const auto& empId : availableEmployeeIds) {
+        admitted[static_cast<int>(__employee_types_by_id.at(empId))].push_back(empId);
+    }
+
+    // the slot of today becomes the new last open day
+    __Day& expired = __dayAt(0);
+    DaySchedule_Type expiredSchedule = std::move(expired.schedule);
+    expired.schedule.clear();
+    expired.assigned.clear();
+    expired.available.swap(admitted);
+
+    __today_slot = (__today_slot + 1) % HORIZON_DAYS;
+    __today++;
+    return expiredSchedule;
+}
+
+bool RollingScheduler::__canBuild(const Building& building, __Day& day, std::vector<int>& assignedEmployees) {
+    const auto* alternative = Scheduler::staffableAlternative(*__building_requirements, building.type,
+        [&](const EmployeeType& empType) { return day.available[static_cast<int>(empType)].size(); });
+    if (alternative == nullptr) {
+        return false;
+    }
+
+    for (const auto& [employeeType, employeeTypeCount] : *alternative) {
+        auto& pool = day.available[static_cast<int>(employeeType)];
+        for (int workers_count = employeeTypeCount; workers_count > 0; workers_count--) {
+            assignedEmployees.push_back(pool.back());
+            day.assigned.insert(pool.back());
+            pool.pop_back();
+        }
+    }
+    return true;
+}
+
+const RollingScheduler::DaySchedule_Type& RollingScheduler::getDaySchedule(const int& offset) const {
+    return __dayAt(offset).schedule;
+}
+
+std::vector<std::pair<std::string, long long>> RollingScheduler::getBacklog() const {
+    std::vector<std::pair<std::string, long long>> backlog;
+    backlog.reserve(__backlog.size());
+    for (const auto& [key, entry] : __backlog) {
+        backlog.push_back(make_pair(entry.building.name, entry.priority + BACKLOG_AGING_PER_DAY * (__today - entry.enqueuedDay)));
+    }
+    return backlog;
+}
+
+long long RollingScheduler::today() const {
+    return __today;
+}
+
+void RollingScheduler::printSchedule() const {
+    cout << "************ SCHEDULE ***************" << endl;
+    for (int offset = 0; offset < HORIZON_DAYS; offset++) {
+        for (const auto& buldingAssignedEmpsPair : __dayAt(offset).schedule) {
+            cout << "Day " << __today + offset << ": ";
+            cout << "Building -> " << buldingAssignedEmpsPair.first << ": | Employees -> ";
+            for (const auto& empId : buldingAssignedEmpsPair.second) {
+                cout << "[" << empId << "] ";
+            }
+            cout << endl;
+        }
+    }
+    cout << "Backlog -> " << __backlog.size() << " building(s)" << endl;
+    cout << "*************************************" << endl;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <memory>
+#include "employee.h"
+#include "building.h"
+#include "days.h"
+#include "scheduler.h"
+
+constexpr int HORIZON_DAYS=WORK_DAYS; //open days from today on
+constexpr int BACKLOG_AGING_PER_DAY=1; //priority a building in the backlog gains each day it waits
+
+
+// Rolling-horizon scheduler: unlike Scheduler, which plans one week and then is rebuilt, it keeps the open days
+// in a ring buffer and advances one day at a time. The day that passes is expired in O(1) and its slot is reused
+// for the newly admitted day. Buildings not placed yet stay in a persistent backlog where they gain priority
+// with age, so they are placed before newer work competing for the same day.
+class RollingScheduler {
+    public:
+        using DaySchedule_Type = std::vector<std::pair<std::string, std::vector<int>>>;
+
+        RollingScheduler();
+        // rules used instead of Scheduler::buildingRequirements; nullptr restores the default
+        void setBuildingRequirements(std::shared_ptr<const Scheduler::BuildingRequrement_Type> requirements);
+        void schedule(); //places the backlog into the open days, earliest day first, highest priority first within a day
+        DaySchedule_Type advanceDay(const std::vector<int>& availableEmployeeIds); //closes today and returns its schedule,
+                                                                                  // the new last day is open to the given employees,
+                                                                                  // an unknown id throws std::out_of_range and changes nothing
+        void printSchedule() const;
+        const DaySchedule_Type& getDaySchedule(const int& offset) const; //offset from today, below HORIZON_DAYS
+        std::vector<std::pair<std::string, long long>> getBacklog() const; //unplaced buildings and their priority today, in placing order
+        long long today() const; //days advanced since construction
+        void updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability); //availability over the open days, from today,
+                                                                                                  // days the employee is already booked are left as they are
+        void addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability);
+        void addBuilding(const std::string& buildName, const BuildingType& buildType, const int& priority = 0);
+
+    private:
+        struct __Day {
+            std::array<std::vector<int>, EMPLOYEE_TYPES> available; //ids of the employees available and not assigned yet, by type
+            std::unordered_set<int> assigned; //ids of the employees booked on a crew that day
+            DaySchedule_Type schedule;
+        };
+        //(-(priority - aging * day enqueued), arrival), the order doesn't change with time as every entry ages at the same rate
+        using __BacklogKey_Type = std::tuple<long long, long long>;
+        struct __BacklogEntry {
+            Building building;
+            int priority;
+            long long enqueuedDay;
+        };
+
+        std::array<__Day, HORIZON_DAYS> __days; //ring buffer of the open days
+        int __today_slot; //slot of today in __days
+        long long __today;
+        long long __arrivals;
+        std::unordered_map<int, EmployeeType> __employee_types_by_id;
+        std::map<__BacklogKey_Type, __BacklogEntry> __backlog;
+        std::shared_ptr<const Scheduler::BuildingRequrement_Type> __building_requirements; //Scheduler::buildingRequirements unless set
+
+        __Day& __dayAt(int offset);
+        const __Day& __dayAt(int offset) const;
+        bool __canBuild(const Building& building, __Day& day, std::vector<int>& assignedEmployees);
+};
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include "rolling_scheduler.h"
+
+using namespace std;
+
+
+class RollingSchedulerTest : public testing::Test {
+  protected:
+        RollingScheduler scheduler;
+};
+
+
+TEST_F(RollingSchedulerTest, unplacedBuildingsStayInBacklog) {
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, false, true, false, false});
+    for (int b = 0; b < 4; b++) {
+        scheduler.addBuilding("Build " + std::to_string(b), BuildingType::SINGLE_STORY);
+    }
+
+    scheduler.schedule();
+    scheduler.printSchedule();
+
+    EXPECT_EQ(1, scheduler.getDaySchedule(0).size());
+    EXPECT_EQ("Build 0", scheduler.getDaySchedule(0)[0].first);
+    EXPECT_EQ(0, scheduler.getDaySchedule(1).size());
+    EXPECT_EQ(1, scheduler.getDaySchedule(2).size());
+    EXPECT_EQ("Build 1", scheduler.getDaySchedule(2)[0].first);
+
+    auto backlog = scheduler.getBacklog();
+    ASSERT_EQ(2, backlog.size());
+    EXPECT_EQ("Build 2", backlog[0].first);
+    EXPECT_EQ("Build 3", backlog[1].first);
+}
+
+TEST_F(RollingSchedulerTest, advanceDayExpiresTodayAndAdmitsNextDay) {
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, false, false, false, false});
+    scheduler.addEmployee(2, EmployeeType::CERTIFIED_INSTALLER, {false, false, false, false, false});
+    scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+    scheduler.addBuilding("Build 1", BuildingType::SINGLE_STORY);
+    scheduler.schedule();
+
+    auto expired = scheduler.advanceDay({2});
+    EXPECT_EQ(1, scheduler.today());
+    ASSERT_EQ(1, expired.size());
+    EXPECT_EQ("Build 0", expired[0].first);
+    EXPECT_EQ(std::vector<int>({1}), expired[0].second);
+    EXPECT_EQ(0, scheduler.getDaySchedule(0).size());
+
+    // the admitted day is the last open day
+    scheduler.schedule();
+    scheduler.printSchedule();
+    auto last = scheduler.getDaySchedule(HORIZON_DAYS - 1);
+    ASSERT_EQ(1, last.size());
+    EXPECT_EQ("Build 1", last[0].first);
+    EXPECT_EQ(std::vector<int>({2}), last[0].second);
+    EXPECT_TRUE(scheduler.getBacklog().empty());
+}
+
+TEST_F(RollingSchedulerTest, advanceDayWithUnknownEmployeeKeepsToday) {
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+    scheduler.schedule();
+
+    EXPECT_THROW(scheduler.advanceDay({1, 99}), std::out_of_range);
+    EXPECT_EQ(0, scheduler.today());
+    ASSERT_EQ(1, scheduler.getDaySchedule(0).size());
+    EXPECT_EQ("Build 0", scheduler.getDaySchedule(0)[0].first);
+
+    auto expired = scheduler.advanceDay({1});
+    EXPECT_EQ(1, scheduler.today());
+    ASSERT_EQ(1, expired.size());
+    EXPECT_EQ("Build 0", expired[0].first);
+}
+
+TEST_F(RollingSchedulerTest, ringWrapsAroundManyDays) {
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    int placed = 0;
+    for (int day = 0; day < 3 * HORIZON_DAYS; day++) {
+        scheduler.addBuilding("Build " + std::to_string(day), BuildingType::SINGLE_STORY);
+        scheduler.schedule();
+        auto expired = scheduler.advanceDay({1});
+        placed += expired.size();
+        ASSERT_EQ(1, expired.size());
+        EXPECT_EQ("Build " + std::to_string(day), expired[0].first);
+    }
+    EXPECT_EQ(3 * HORIZON_DAYS, placed);
+    EXPECT_EQ(3 * HORIZON_DAYS, scheduler.today());
+}
+
+TEST_F(RollingSchedulerTest, backlogAgingRaisesPriority) {
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {false, false, false, false, false});
+    scheduler.addBuilding("Old", BuildingType::SINGLE_STORY, 0);
+    for (int day = 0; day < 3; day++) {
+        scheduler.schedule();
+        scheduler.advanceDay({});
+    }
+
+    // a newer building with a higher base priority ranks below the one waiting for three days
+    scheduler.addBuilding("Urgent", BuildingType::SINGLE_STORY, 2);
+    scheduler.addBuilding("Very urgent", BuildingType::SINGLE_STORY, 5);
+    auto backlog = scheduler.getBacklog();
+    ASSERT_EQ(3, backlog.size());
+    EXPECT_EQ("Very urgent", backlog[0].first);
+    EXPECT_EQ(5, backlog[0].second);
+    EXPECT_EQ("Old", backlog[1].first);
+    EXPECT_EQ(3, backlog[1].second);
+    EXPECT_EQ("Urgent", backlog[2].first);
+
+    scheduler.updateAvailability(1, {true, false, false, false, false});
+    scheduler.schedule();
+    EXPECT_EQ("Very urgent", scheduler.getDaySchedule(0)[0].first);
+}
+
+TEST_F(RollingSchedulerTest, unchangedAvailabilityKeepsBookedEmployeesOut) {
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, false, false, false, false});
+    scheduler.addBuilding("A", BuildingType::SINGLE_STORY);
+    scheduler.schedule();
+
+    scheduler.updateAvailability(1, {true, false, false, false, false});
+    scheduler.addBuilding("B", BuildingType::SINGLE_STORY);
+    scheduler.schedule();
+
+    ASSERT_EQ(1, scheduler.getDaySchedule(0).size());
+    EXPECT_EQ("A", scheduler.getDaySchedule(0)[0].first);
+    ASSERT_EQ(1, scheduler.getBacklog().size());
+    EXPECT_EQ("B", scheduler.getBacklog()[0].first);
+
+    // booked again once the day is over
+    scheduler.advanceDay({});
+    for (int days = 1; days < HORIZON_DAYS; days++) {
+        scheduler.advanceDay({});
+    }
+    scheduler.updateAvailability(1, {true, false, false, false, false});
+    scheduler.schedule();
+    ASSERT_EQ(1, scheduler.getDaySchedule(0).size());
+    EXPECT_EQ("B", scheduler.getDaySchedule(0)[0].first);
+}
+
+TEST_F(RollingSchedulerTest, perSchedulerBuildingRequirements) {
+    auto laborOnly = std::make_shared<Scheduler::BuildingRequrement_Type>(Scheduler::BuildingRequrement_Type{
+        {BuildingType::SINGLE_STORY, {{{EmployeeType::LABORER, 1}}}}
+    });
+    scheduler.setBuildingRequirements(laborOnly);
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    scheduler.addEmployee(2, EmployeeType::LABORER, {true, false, false, false, false});
+    scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+    scheduler.addBuilding("Build 1", BuildingType::SINGLE_STORY);
+    scheduler.addBuilding("Build 2", BuildingType::TWO_STORY);
+    scheduler.schedule();
+
+    ASSERT_EQ(1, scheduler.getDaySchedule(0).size());
+    EXPECT_EQ(std::vector<int>({2}), scheduler.getDaySchedule(0)[0].second);
+    EXPECT_EQ(2, scheduler.getBacklog().size()); //no laborer left, no rule for two-story
+
+    // back to the default table, a certified installer staffs a single-story
+    scheduler.setBuildingRequirements(nullptr);
+    scheduler.schedule();
+    ASSERT_EQ(2, scheduler.getDaySchedule(0).size());
+    EXPECT_EQ(std::vector<int>({1}), scheduler.getDaySchedule(0)[1].second);
+    ASSERT_EQ(1, scheduler.getBacklog().size());
+    EXPECT_EQ("Build 2", scheduler.getBacklog()[0].first);
+}
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <unordered_map>
+
+#include "schedule_diff.h"
+#include "byte_codec.h"
+
+using namespace std;
+
+namespace {
+constexpr uint8_t DELTA_FORMAT_VERSION = 1;
+
+// day and sorted crew of a building in one schedule, day -1 when it is not scheduled there
+struct Slot {
+    int day = -1;
+    vector<int> crew;
+};
+
+void putIds(string& bytes, span<const int> ids) {
+    putVarint(bytes, ids.size());
+    int64_t previous = 0;
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (i == 0) {
+            putSigned(bytes, ids[i]);
+        } else {
+            putVarint(bytes, static_cast<uint64_t>(static_cast<int64_t>(ids[i]) - previous)); //sorted, never negative
+        }
+        previous = ids[i];
+    }
+}
+
+void getIds(ByteReader& reader, vector<int>& ids, uint32_t& begin, uint32_t& count) {
+    size_t size = reader.getCount();
+    begin = static_cast<uint32_t>(ids.size());
+    count = static_cast<uint32_t>(size);
+    int64_t previous = 0;
+    for (size_t i = 0; i < size; i++) {
+        int64_t id;
+        if (i == 0) {
+            id = reader.getSigned();
+        } else {
+            uint64_t gap = reader.getVarint();
+            if (gap > static_cast<uint64_t>(INT32_MAX - previous)) { //previous is a valid id, so this can't be negative
+                reader.fail("has an invalid employee id");
+            }
+            id = previous + static_cast<int64_t>(gap);
+        }
+        if (id < INT32_MIN || id > INT32_MAX) {
+            reader.fail("has an invalid employee id");
+        }
+        ids.push_back(static_cast<int>(id));
+        previous = id;
+    }
+}
+
+int getDay(ByteReader& reader) {
+    int day = static_cast<int>(reader.getByte()) - 1;
+    if (day >= WORK_DAYS) {
+        reader.fail("has an invalid day");
+    }
+    return day;
+}
+}
+
+ScheduleDelta diff(const Schedule_Type& before, const Schedule_Type& after) {
+    size_t entries = 0;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        entries += before[day].size() + after[day].size();
+    }
+    unordered_map<string_view, uint32_t> building_ids;
+    building_ids.reserve(entries);
+    vector<string_view> names;
+    vector<Slot> old_slots, new_slots;
+
+    auto intern = [&](const string& name) {
+        auto [found, inserted] = building_ids.try_emplace(name, static_cast<uint32_t>(names.size()));
+        if (inserted) {
+            names.push_back(name);
+            old_slots.emplace_back();
+            new_slots.emplace_back();
+        }
+        return found->second;
+    };
+    auto fill = [&](const Schedule_Type& schedule, vector<Slot>& slots) {
+        for (int day = 0; day < WORK_DAYS; day++) {
+            for (const auto& [buildName, crew] : schedule[day]) {
+                Slot& slot = slots[intern(buildName)];
+                slot.day = day;
+                slot.crew = crew;
+                sort(slot.crew.begin(), slot.crew.end());
+            }
+        }
+    };
+    fill(before, old_slots);
+    fill(after, new_slots);
+
+    ScheduleDelta delta;
+    auto addChange = [&](ScheduleChangeKind kind, uint32_t building, const Slot& old_slot, const Slot& new_slot) {
+        ScheduleChange change{kind, static_cast<uint32_t>(delta.buildings.size()), old_slot.day, new_slot.day, 0, 0, 0, 0};
+        delta.buildings.emplace_back(names[building]);
+        change.joinedBegin = static_cast<uint32_t>(delta.crewIds.size());
+        if (kind == ScheduleChangeKind::CHANGED) {
+            set_difference(new_slot.crew.begin(), new_slot.crew.end(), old_slot.crew.begin(), old_slot.crew.end(), back_inserter(delta.crewIds));
+        } else {
+            delta.crewIds.insert(delta.crewIds.end(), new_slot.crew.begin(), new_slot.crew.end());
+        }
+        change.joinedCount = static_cast<uint32_t>(delta.crewIds.size()) - change.joinedBegin;
+        change.leftBegin = static_cast<uint32_t>(delta.crewIds.size());
+        if (kind == ScheduleChangeKind::CHANGED) {
+            set_difference(old_slot.crew.begin(), old_slot.crew.end(), new_slot.crew.begin(), new_slot.crew.end(), back_inserter(delta.crewIds));
+        } else {
+            delta.crewIds.insert(delta.crewIds.end(), old_slot.crew.begin(), old_slot.crew.end());
+        }
+        change.leftCount = static_cast<uint32_t>(delta.crewIds.size()) - change.leftBegin;
+        delta.changes.push_back(change);
+    };
+
+    for (uint32_t building = 0; building < names.size(); building++) {
+        const Slot& old_slot = old_slots[building];
+        const Slot& new_slot = new_slots[building];
+        if (old_slot.day < 0) {
+            addChange(ScheduleChangeKind::ADDED, building, old_slot, new_slot);
+        } else if (new_slot.day < 0) {
+            addChange(ScheduleChangeKind::REMOVED, building, old_slot, new_slot);
+        } else if (old_slot.day != new_slot.day || old_slot.crew != new_slot.crew) {
+            addChange(ScheduleChangeKind::CHANGED, building, old_slot, new_slot);
+        }
+    }
+    return delta;
+}
+
+std::string serializeDelta(const ScheduleDelta& delta) {
+    string bytes;
+    bytes.reserve(8 + delta.changes.size() * 6 + delta.crewIds.size() * 2);
+    bytes.push_back(static_cast<char>(DELTA_FORMAT_VERSION));
+    putVarint(bytes, delta.buildings.size());
+    for (const auto& name : delta.buildings) {
+        putText(bytes, name);
+    }
+    putVarint(bytes, delta.changes.size());
+    for (const auto& change : delta.changes) {
+        bytes.push_back(static_cast<char>(change.kind));
+        putVarint(bytes, change.building);
+        bytes.push_back(static_cast<char>(change.previousDay + 1));
+        bytes.push_back(static_cast<char>(change.day + 1));
+        putIds(bytes, delta.joined(change));
+        putIds(bytes, delta.left(change));
+    }
+    return bytes;
+}
+
+ScheduleDelta deserializeDelta(std::string_view bytes) {
+    ByteReader reader(bytes, "schedule delta");
+    if (reader.getByte() != DELTA_FORMAT_VERSION) {
+        reader.fail("has an unknown format");
+    }
+    ScheduleDelta delta;
+    delta.buildings.resize(reader.getCount());
+    for (auto& name : delta.buildings) {
+        name = reader.getText();
+    }
+    delta.changes.resize(reader.getCount());
+    for (auto& change : delta.changes) {
+        uint8_t kind = reader.getByte();
+        if (kind > static_cast<uint8_t>(ScheduleChangeKind::CHANGED)) {
+            reader.fail("has an invalid change kind");
+        }
+        change.kind = static_cast<ScheduleChangeKind>(kind);
+        uint64_t building = reader.getVarint();
+        if (building >= delta.buildings.size()) {
+            reader.fail("has an invalid building");
+        }
+        change.building = static_cast<uint32_t>(building);
+        change.previousDay = getDay(reader);
+        change.day = getDay(reader);
+        getIds(reader, delta.crewIds, change.joinedBegin, change.joinedCount);
+        getIds(reader, delta.crewIds, change.leftBegin, change.leftCount);
+        // the days and crews diff() fills for each kind
+        bool consistent = false;
+        switch (change.kind) {
+            case ScheduleChangeKind::ADDED:
+                consistent = change.previousDay == -1 && change.day >= 0 && change.leftCount == 0;
+                break;
+            case ScheduleChangeKind::REMOVED:
+                consistent = change.previousDay >= 0 && change.day == -1 && change.joinedCount == 0;
+                break;
+            case ScheduleChangeKind::CHANGED:
+                consistent = change.previousDay >= 0 && change.day >= 0;
+                break;
+        }
+        if (!consistent) {
+            reader.fail("has a change inconsistent with its kind");
+        }
+    }
+    if (!reader.atEnd()) {
+        reader.fail("has trailing bytes");
+    }
+    return delta;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include "scheduler.h"
+
+
+enum class ScheduleChangeKind : std::uint8_t {
+    ADDED,   //scheduled in the new schedule only
+    REMOVED, //scheduled in the old schedule only
+    CHANGED  //scheduled in both, on another day or with another crew
+};
+
+// one changed building, the crew ids are ranges of ScheduleDelta::crewIds
+struct ScheduleChange {
+    ScheduleChangeKind kind;
+    std::uint32_t building;   //index in ScheduleDelta::buildings
+    std::int32_t previousDay; //-1 when ADDED
+    std::int32_t day;         //-1 when REMOVED
+    std::uint32_t joinedBegin; //ADDED: the whole crew, CHANGED: the employees who joined it
+    std::uint32_t joinedCount;
+    std::uint32_t leftBegin;   //REMOVED: the whole crew, CHANGED: the employees who left it
+    std::uint32_t leftCount;
+};
+
+// what changed between two schedules, crews as sorted id ranges in one flat array
+struct ScheduleDelta {
+    std::vector<std::string> buildings; //names of the changed buildings only
+    std::vector<ScheduleChange> changes;
+    std::vector<int> crewIds;
+
+    bool empty() const {
+        return changes.empty();
+    }
+    std::span<const int> joined(const ScheduleChange& change) const {
+        return std::span<const int>(crewIds).subspan(change.joinedBegin, change.joinedCount);
+    }
+    std::span<const int> left(const ScheduleChange& change) const {
+        return std::span<const int>(crewIds).subspan(change.leftBegin, change.leftCount);
+    }
+};
+
+// Changes from before to after. Building names are interned to ids once and matched by id, crews are compared
+// as sorted id arrays, so the cost is linear in the size of both schedules (plus sorting each crew).
+// Names are expected to be unique within a schedule, as for Scheduler::getBuildingAssignment.
+ScheduleDelta diff(const Schedule_Type& before, const Schedule_Type& after);
+
+// Compact byte encoding for the message bus: LEB128 varints, sorted crew ids as gaps from the previous id.
+std::string serializeDelta(const ScheduleDelta& delta);
+ScheduleDelta deserializeDelta(std::string_view bytes); //throws std::runtime_error on malformed input
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <climits>
+#include "schedule_diff.h"
+#include "byte_codec.h"
+
+using namespace std;
+
+
+class ScheduleDiffTest : public testing::Test {
+  protected:
+        Schedule_Type before;
+        Schedule_Type after;
+
+        const ScheduleChange* findChange(const ScheduleDelta& delta, const string& buildName) {
+            for (const auto& change : delta.changes) {
+                if (delta.buildings[change.building] == buildName) {
+                    return &change;
+                }
+            }
+            return nullptr;
+        }
+};
+
+
+TEST_F(ScheduleDiffTest, identicalSchedulesHaveNoChanges) {
+    before[0] = {{"Build 1", {3, 1}}, {"Build 2", {2}}};
+    after = before;
+    after[0][0].second = {1, 3}; //crew order doesn't matter
+
+    ScheduleDelta delta = diff(before, after);
+    EXPECT_TRUE(delta.empty());
+    EXPECT_TRUE(delta.buildings.empty());
+    EXPECT_TRUE(diff(Schedule_Type{}, Schedule_Type{}).empty());
+}
+
+TEST_F(ScheduleDiffTest, addedRemovedAndChangedAssignments) {
+    before[0] = {{"Kept", {1, 2}}, {"Removed", {3}}};
+    before[1] = {{"Moved", {4}}, {"Recrewed", {5, 6, 7}}};
+    after[0] = {{"Kept", {2, 1}}, {"Added", {9, 8}}};
+    after[1] = {{"Recrewed", {7, 10, 5}}};
+    after[3] = {{"Moved", {4}}};
+
+    ScheduleDelta delta = diff(before, after);
+    ASSERT_EQ(4, delta.changes.size());
+    EXPECT_EQ(nullptr, findChange(delta, "Kept"));
+
+    const ScheduleChange* removed = findChange(delta, "Removed");
+    ASSERT_NE(nullptr, removed);
+    EXPECT_EQ(ScheduleChangeKind::REMOVED, removed->kind);
+    EXPECT_EQ(0, removed->previousDay);
+    EXPECT_EQ(-1, removed->day);
+    EXPECT_TRUE(delta.joined(*removed).empty());
+    EXPECT_EQ(vector<int>({3}), vector<int>(delta.left(*removed).begin(), delta.left(*removed).end()));
+
+    const ScheduleChange* added = findChange(delta, "Added");
+    ASSERT_NE(nullptr, added);
+    EXPECT_EQ(ScheduleChangeKind::ADDED, added->kind);
+    EXPECT_EQ(-1, added->previousDay);
+    EXPECT_EQ(0, added->day);
+    EXPECT_EQ(vector<int>({8, 9}), vector<int>(delta.joined(*added).begin(), delta.joined(*added).end()));
+
+    const ScheduleChange* moved = findChange(delta, "Moved");
+    ASSERT_NE(nullptr, moved);
+    EXPECT_EQ(ScheduleChangeKind::CHANGED, moved->kind);
+    EXPECT_EQ(1, moved->previousDay);
+    EXPECT_EQ(3, moved->day);
+    EXPECT_TRUE(delta.joined(*moved).empty());
+    EXPECT_TRUE(delta.left(*moved).empty());
+
+    const ScheduleChange* recrewed = findChange(delta, "Recrewed");
+    ASSERT_NE(nullptr, recrewed);
+    EXPECT_EQ(ScheduleChangeKind::CHANGED, recrewed->kind);
+    EXPECT_EQ(1, recrewed->day);
+    EXPECT_EQ(vector<int>({10}), vector<int>(delta.joined(*recrewed).begin(), delta.joined(*recrewed).end()));
+    EXPECT_EQ(vector<int>({6}), vector<int>(delta.left(*recrewed).begin(), delta.left(*recrewed).end()));
+}
+
+TEST_F(ScheduleDiffTest, serializationRoundTrip) {
+    before[0] = {{"Removed", {-5, 3, 2000000000}}};
+    before[2] = {{"Recrewed", {1, 2}}};
+    after[2] = {{"Recrewed", {2, 70000}}};
+    after[4] = {{"Added with a long building name", {-2147483647 - 1, 0, 2147483647}}};
+
+    ScheduleDelta delta = diff(before, after);
+    string bytes = serializeDelta(delta);
+    ScheduleDelta decoded = deserializeDelta(bytes);
+
+    EXPECT_EQ(delta.buildings, decoded.buildings);
+    EXPECT_EQ(delta.crewIds, decoded.crewIds);
+    ASSERT_EQ(delta.changes.size(), decoded.changes.size());
+    for (size_t c = 0; c < delta.changes.size(); c++) {
+        const ScheduleChange& expected = delta.changes[c];
+        const ScheduleChange& actual = decoded.changes[c];
+        EXPECT_EQ(expected.kind, actual.kind);
+        EXPECT_EQ(expected.building, actual.building);
+        EXPECT_EQ(expected.previousDay, actual.previousDay);
+        EXPECT_EQ(expected.day, actual.day);
+        EXPECT_TRUE(std::ranges::equal(delta.joined(expected), decoded.joined(actual)));
+        EXPECT_TRUE(std::ranges::equal(delta.left(expected), decoded.left(actual)));
+    }
+    EXPECT_TRUE(deserializeDelta(serializeDelta(ScheduleDelta{})).empty());
+}
+
+TEST_F(ScheduleDiffTest, malformedBytesAreRejected) {
+    before[0] = {{"Build 1", {1, 2, 3}}};
+    string bytes = serializeDelta(diff(before, after));
+
+    EXPECT_THROW(deserializeDelta(""), std::runtime_error);
+    EXPECT_THROW(deserializeDelta(bytes.substr(0, bytes.size() - 1)), std::runtime_error);
+    EXPECT_THROW(deserializeDelta(bytes + "x"), std::runtime_error);
+    string wrong_version = bytes;
+    wrong_version[0] = 42;
+    EXPECT_THROW(deserializeDelta(wrong_version), std::runtime_error);
+}
+
+TEST_F(ScheduleDiffTest, craftedIdsAndDaysAreRejected) {
+    // one CHANGED building whose second crew id is a gap past INT32_MAX, and the same change with valid ids
+    auto changeBytes = [](std::uint64_t gap, ScheduleChangeKind kind, int previousDay, int day) {
+        string bytes(1, 1);
+        putVarint(bytes, 1);
+        putText(bytes, "Build 0");
+        putVarint(bytes, 1);
+        bytes.push_back(static_cast<char>(kind));
+        putVarint(bytes, 0);
+        bytes.push_back(static_cast<char>(previousDay + 1));
+        bytes.push_back(static_cast<char>(day + 1));
+        putVarint(bytes, 2);
+        putSigned(bytes, INT32_MAX - 5);
+        putVarint(bytes, gap);
+        putVarint(bytes, 0);
+        return bytes;
+    };
+
+    EXPECT_EQ(1, deserializeDelta(changeBytes(5, ScheduleChangeKind::CHANGED, 0, 1)).changes.size());
+    EXPECT_THROW(deserializeDelta(changeBytes(6, ScheduleChangeKind::CHANGED, 0, 1)), std::runtime_error);
+    EXPECT_THROW(deserializeDelta(changeBytes(UINT64_MAX, ScheduleChangeKind::CHANGED, 0, 1)), std::runtime_error);
+
+    EXPECT_EQ(1, deserializeDelta(changeBytes(5, ScheduleChangeKind::ADDED, -1, 1)).changes.size());
+    EXPECT_THROW(deserializeDelta(changeBytes(5, ScheduleChangeKind::ADDED, 0, 1)), std::runtime_error);
+    EXPECT_THROW(deserializeDelta(changeBytes(5, ScheduleChangeKind::REMOVED, 0, -1)), std::runtime_error); //a removed crew doesn't join
+    EXPECT_THROW(deserializeDelta(changeBytes(5, ScheduleChangeKind::CHANGED, -1, 1)), std::runtime_error);
+    EXPECT_THROW(deserializeDelta(changeBytes(5, ScheduleChangeKind::CHANGED, 0, -1)), std::runtime_error);
+}
+
+TEST_F(ScheduleDiffTest, diffBetweenSchedulerRuns) {
+    Scheduler scheduler;
+    for (int b = 0; b < 6; b++) {
+        scheduler.addBuilding("Build " + to_string(b), BuildingType::TWO_STORY);
+    }
+    for (int id = 1; id <= 4; id++) {
+        scheduler.addEmployee(id, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, false, false});
+        scheduler.addEmployee(10 + id, EmployeeType::LABORER, {true, true, true, false, false});
+    }
+    Scheduler rescheduled = scheduler;
+    scheduler.schedule();
+
+    // a laborer calls in sick on monday
+    rescheduled.updateAvailability(14, {false, true, true, false, false});
+    rescheduled.schedule();
+
+    ScheduleDelta delta = diff(scheduler.getSchedule(), rescheduled.getSchedule());
+    ASSERT_FALSE(delta.empty());
+    bool sick_left = false;
+    for (const auto& change : delta.changes) {
+        EXPECT_EQ(ScheduleChangeKind::CHANGED, change.kind);
+        for (int id : delta.left(change)) {
+            sick_left |= id == 14 && change.previousDay == 0;
+        }
+    }
+    EXPECT_TRUE(sick_left);
+}
+
+TEST_F(ScheduleDiffTest, deltaIsSmallForALocalChange) {
+    for (int b = 0; b < 1000; b++) {
+        before[b % WORK_DAYS].push_back(make_pair("Build " + to_string(b), vector<int>({b, b + 1000, b + 2000})));
+    }
+    after = before;
+    after[2][7].second[1] = 5000;
+
+    ScheduleDelta delta = diff(before, after);
+    ASSERT_EQ(1, delta.changes.size());
+    EXPECT_EQ(vector<string>({before[2][7].first}), delta.buildings);
+    // only the change travels: kind, building, days and the two ids
+    EXPECT_LT(serializeDelta(delta).size(), 32);
+}
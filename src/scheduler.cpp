@@ -1,26 +1,114 @@
 #include <iostream>
 #include <algorithm>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
 
 #include "scheduler.h"
+#include "operation_log.h"
 
 using namespace std;
 
-Scheduler::BuildingRequrement_Type Scheduler::buildingRequirements = {
-            {BuildingType::SINGLE_STORY, {{EmployeeType::CERTIFIED_INSTALLER, 1}}},
-            {BuildingType::TWO_STORY, {{EmployeeType::CERTIFIED_INSTALLER, 1}, {EmployeeType::INSTALLER_PENDING_CERTIFICATION, 1}}},
-            {BuildingType::TWO_STORY, {{EmployeeType::CERTIFIED_INSTALLER, 1}, {EmployeeType::LABORER, 1}}},
-            {BuildingType::COMMERCIAL, {{EmployeeType::CERTIFIED_INSTALLER, 2}, {EmployeeType::INSTALLER_PENDING_CERTIFICATION, 6}}},
-            {BuildingType::COMMERCIAL, {{EmployeeType::CERTIFIED_INSTALLER, 6}, {EmployeeType::INSTALLER_PENDING_CERTIFICATION, 2}}},
-            {BuildingType::COMMERCIAL, {{EmployeeType::CERTIFIED_INSTALLER, 2}, {EmployeeType::INSTALLER_PENDING_CERTIFICATION, 2}, {EmployeeType::LABORER, 4}}}
-        };
+Scheduler::BuildingRequrement_Type Scheduler::requirementsFrom(std::span<const StaticRequirement<EMPLOYEE_TYPES>> table) {
+    BuildingRequrement_Type requirements;
+    for (const auto& rule : table) {
+        RequirementAlternative_Type alternative;
+        for (int type = 0; type < EMPLOYEE_TYPES; type++) {
+            if (rule.staff[type] > 0) {
+                alternative.push_back(make_pair(static_cast<EmployeeType>(type), rule.staff[type]));
+            }
+        }
+        requirements[rule.buildingType].push_back(std::move(alternative));
+    }
+    return requirements;
+}
+
+Scheduler::BuildingRequrement_Type Scheduler::buildingRequirements = Scheduler::requirementsFrom(defaultBuildingRequirements);
 
 Scheduler::Scheduler():
     __buildings(),
     __employees_by_id(),
     __employees_by_type_and_day(),
-    __daily_schedule()
+    __daily_schedule(),
+    __assignment_policy(AssignmentPolicy::GREEDY),
+    __weekly_hour_cap(0),
+    __assignment_seq(0),
+    __policy_heaps(),
+    __nearest_trees(),
+    __travel_distance(0),
+    __building_names(),
+    __building_id_by_name(),
+    __schedule_slot_by_building(),
+    __assignments_by_employee(),
+    __operation_log(nullptr),
+    __diagnostics(false),
+    __building_shortfalls(),
+    __available_at_end_of_day(),
+    __capacity_report(),
+    __building_requirements(&buildingRequirements, [](const BuildingRequrement_Type*) {}) //static, not owned
     {}
 
+Scheduler::Scheduler(const Scheduler& other):
+    __buildings(other.__buildings),
+    __employees_by_id(other.__employees_by_id),
+    __employees_by_type_and_day(other.__employees_by_type_and_day),
+    __daily_schedule(other.__daily_schedule),
+    __assignment_policy(other.__assignment_policy),
+    __weekly_hour_cap(other.__weekly_hour_cap),
+    __assignment_seq(other.__assignment_seq),
+    __policy_heaps(other.__policy_heaps),
+    __nearest_trees(other.__nearest_trees),
+    __travel_distance(other.__travel_distance),
+    __building_names(other.__building_names),
+    __building_id_by_name(),
+    __schedule_slot_by_building(other.__schedule_slot_by_building),
+    __assignments_by_employee(other.__assignments_by_employee),
+    __operation_log(nullptr), //the calls on the copy are not the ones of the logged scheduler
+    __diagnostics(other.__diagnostics),
+    __building_shortfalls(other.__building_shortfalls),
+    __available_at_end_of_day(other.__available_at_end_of_day),
+    __capacity_report(other.__capacity_report),
+    __building_requirements(other.__building_requirements)
+    {
+    // the copied pools and views still point into other
+    for (auto& [empType, pools] : __employees_by_type_and_day) {
+        for (auto& pool : pools) {
+            for (Employee*& emp : pool) {
+                emp = &__employees_by_id.at(emp->id);
+            }
+        }
+    }
+    for (int id = 0; id < static_cast<int>(__building_names.size()); id++) {
+        __building_id_by_name.emplace(__building_names[id], id);
+    }
+    for (auto& [employeeId, assignments] : __assignments_by_employee) {
+        for (EmployeeAssignment& assignment : assignments) {
+            assignment.building = __building_names[other.__building_id_by_name.at(assignment.building)];
+        }
+    }
+}
+
+Scheduler& Scheduler::operator=(const Scheduler& other) {
+    if (this != &other) {
+        *this = Scheduler(other);
+    }
+    return *this;
+}
+
+void Scheduler::setBuildingRequirements(std::shared_ptr<const BuildingRequrement_Type> requirements) {
+    if (__operation_log) {
+        __operation_log->recordBuildingRequirements(requirements.get());
+    }
+    if (!requirements) {
+        requirements = std::shared_ptr<const BuildingRequrement_Type>(&buildingRequirements, [](const BuildingRequrement_Type*) {});
+    }
+    __building_requirements = std::move(requirements);
+}
+
+std::shared_ptr<const Scheduler::BuildingRequrement_Type> Scheduler::getBuildingRequirements() const {
+    return __building_requirements;
+}
+
 
 void Scheduler::__addEmployeeToAvailByTypeAndDay(const EmployeeType& empType, const int& employeeId, const std::vector<bool>& empAvailability) {
     for (DayOfWeek day = DayOfWeek::MONDAY; static_cast<int>(day) < WORK_DAYS; ++day) {
@@ -32,8 +120,19 @@ void Scheduler::__addEmployeeToAvailByTypeAndDay(const EmployeeType& empType, co
 }
 
 
-void Scheduler::addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability) {
+void Scheduler::addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability, const Location& empLocation) {
+    if (__operation_log) {
+        __operation_log->recordAddEmployee(employeeId, empType, empAvailability, empLocation);
+    }
+    if (auto known = __employees_by_id.find(employeeId); known != __employees_by_id.end()) {
+        // added again: the record is replaced, so it leaves the pools of its old type and days first
+        auto old_pools = __employees_by_type_and_day.find(known->second.type);
+        for (auto& pool : old_pools->second) {
+            std::erase(pool, &known->second);
+        }
+    }
     __employees_by_id[employeeId] = Employee(employeeId, empType, empAvailability);
+    __employees_by_id[employeeId].location = empLocation;
 
     if (__employees_by_type_and_day.find(empType) != __employees_by_type_and_day.end()) {
         __addEmployeeToAvailByTypeAndDay(empType, employeeId, empAvailability);
@@ -48,42 +147,305 @@ void Scheduler::addEmployee(const int& employeeId, const EmployeeType& empType,
 
 
 
-void Scheduler::addBuilding(const std::string& buildName, const BuildingType& buildType) {
-    __buildings.push_back(Building(buildName, buildType));
+void Scheduler::addBuilding(const std::string& buildName, const BuildingType& buildType, const Location& buildLocation) {
+    if (__building_id_by_name.contains(buildName)) {
+        throw invalid_argument("building " + buildName + " was already added"); //the name is the key of getBuildingAssignment
+    }
+    if (__operation_log) {
+        __operation_log->recordAddBuilding(buildName, buildType, buildLocation);
+    }
+    __internBuildingName(buildName);
+    __buildings.push_back(Building(buildName, buildType, buildLocation));
+}
+
+void Scheduler::setAssignmentPolicy(const AssignmentPolicy& policy) {
+    if (__operation_log) {
+        __operation_log->recordAssignmentPolicy(policy);
+    }
+    __assignment_policy = policy;
+}
+
+void Scheduler::setWeeklyHourCap(const int& hours) {
+    if (__operation_log) {
+        __operation_log->recordWeeklyHourCap(hours);
+    }
+    __weekly_hour_cap = hours;
+}
+
+void Scheduler::startWeek() {
+    if (__operation_log) {
+        __operation_log->recordStartWeek();
+    }
+    for (auto& [employeeId, employee] : __employees_by_id) {
+        employee.assignedHours = 0;
+    }
+}
+
+void Scheduler::setOperationLog(OperationLog* log) {
+    if (log != nullptr) {
+        // a log attached to a scheduler with state starts from that state, so replaying it from a new scheduler ends up here
+        if (__building_requirements.get() != &buildingRequirements) {
+            log->recordBuildingRequirements(__building_requirements.get());
+        }
+        static const std::string empty_snapshot = Scheduler().saveSnapshot();
+        std::string snapshot = saveSnapshot();
+        if (snapshot != empty_snapshot) {
+            log->recordLoadSnapshot(snapshot);
+        }
+    }
+    __operation_log = log;
+}
+
+OperationLog* Scheduler::getOperationLog() const {
+    return __operation_log;
+}
+
+double Scheduler::getTravelDistance() const {
+    return __travel_distance;
+}
+
+int Scheduler::getAssignedHours(const int& employeeId) const {
+    return __employees_by_id.at(employeeId).assignedHours;
 }
 
 void Scheduler::schedule() {
-    for (DayOfWeek day = DayOfWeek::MONDAY; static_cast<int>(day) < WORK_DAYS; ++day) {
-        int int_day = static_cast<int>(day);
-        for (auto it = __buildings.begin(); it != __buildings.end(); ) {
-            auto building = *it;
+    __ScheduleCursor cursor = __beginSchedule();
+    __scheduleChunk(cursor, SIZE_MAX);
+    __endSchedule(cursor);
+}
+
+struct Scheduler::__AsyncRun {
+    Scheduler* scheduler;
+    ScheduleExecutor_Type executor;
+    std::stop_token stopToken;
+    ScheduleProgressCallback_Type onProgress;
+    std::size_t chunkSize;
+    bool started = false;
+    bool ended = false;
+    __ScheduleCursor cursor{};
+    std::promise<ScheduleStatus> done;
+
+    void finish(ScheduleStatus status) {
+        if (started && !ended) {
+            ended = true;
+            scheduler->__endSchedule(cursor);
+        }
+        done.set_value(status);
+    }
+
+    // one chunk per task, the next chunk is posted before returning so no thread waits on the run
+    static void step(const std::shared_ptr<__AsyncRun>& run) {
+        try {
+            if (run->stopToken.stop_requested()) {
+                run->finish(ScheduleStatus::CANCELLED);
+                return;
+            }
+            if (!run->started) {
+                run->cursor = run->scheduler->__beginSchedule();
+                run->started = true;
+            }
+            bool finished = run->scheduler->__scheduleChunk(run->cursor, run->chunkSize);
+            if (run->onProgress) {
+                run->onProgress(run->scheduler->__progressOf(run->cursor));
+            }
+            if (finished) {
+                run->finish(ScheduleStatus::COMPLETED);
+                return;
+            }
+            run->executor([run] { step(run); });
+        } catch (...) {
+            std::exception_ptr error = std::current_exception();
+            if (run->started && !run->ended) {
+                run->ended = true;
+                try {
+                    run->scheduler->__endSchedule(run->cursor);
+                } catch (...) {
+                    //the log failed too, the first error is the one reported
+                }
+            }
+            run->done.set_exception(error);
+        }
+    }
+};
+
+std::future<ScheduleStatus> Scheduler::scheduleAsync(const ScheduleExecutor_Type& executor, std::stop_token stopToken,
+                                                     const ScheduleProgressCallback_Type& onProgress, std::size_t chunkSize) {
+    auto run = std::make_shared<__AsyncRun>();
+    run->scheduler = this;
+    run->executor = executor;
+    run->stopToken = std::move(stopToken);
+    run->onProgress = onProgress;
+    run->chunkSize = std::max<std::size_t>(chunkSize, 1);
+    std::future<ScheduleStatus> result = run->done.get_future();
+    executor([run] { __AsyncRun::step(run); });
+    return result;
+}
+
+Scheduler::__ScheduleCursor Scheduler::__beginSchedule() {
+    // employees may have reached the cap in an earlier run or the cap was lowered since
+    for (int day = 0; day < WORK_DAYS; day++) {
+        __dropCapped(day);
+    }
+    if (__assignment_policy == AssignmentPolicy::NEAREST) {
+        __buildNearestTrees();
+    } else if (__assignment_policy != AssignmentPolicy::GREEDY) {
+        __buildPolicyHeaps();
+    }
+    if (__diagnostics) {
+        __building_shortfalls.assign(__buildings.size(), {});
+        __available_at_end_of_day = {};
+    }
+    return __ScheduleCursor{static_cast<int>(DayOfWeek::MONDAY), 0, 0, 0, 0};
+}
+
+bool Scheduler::__scheduleChunk(__ScheduleCursor& cursor, std::size_t maxBuildings) {
+    for (; cursor.day < WORK_DAYS; cursor.day++) {
+        if (cursor.read == 0 && __assignment_policy == AssignmentPolicy::GREEDY) {
+            __dropCapped(cursor.day); //the ones capped on the earlier days, the other policies drop them from their heaps and trees
+        }
+        // stable in-place compaction of the buildings left, keeps their order
+        for (; cursor.read < __buildings.size(); cursor.read++) {
+            if (maxBuildings == 0) {
+                return false;
+            }
+            maxBuildings--;
+            cursor.tried++;
+            Building& building = __buildings[cursor.read];
             std::vector<int> assignedEmployees;
+            DayShortfall* shortfall = __diagnostics ? &__building_shortfalls[cursor.read][cursor.day] : nullptr;
 
-            if (__canBuild(building, int_day, assignedEmployees)) {
-                __assignEmployees(building, int_day, assignedEmployees);
-                it = __buildings.erase(it);
+            if (__canBuild(building, cursor.day, assignedEmployees, shortfall)) {
+                __assignEmployees(building, cursor.day, assignedEmployees);
+                cursor.scheduled++;
             } else {
-                ++it;
+                if (cursor.write != cursor.read) {
+                    __buildings[cursor.write] = std::move(building);
+                    if (__diagnostics) {
+                        __building_shortfalls[cursor.write] = __building_shortfalls[cursor.read];
+                    }
+                }
+                cursor.write++;
+            }
+        }
+        __buildings.erase(__buildings.begin() + cursor.write, __buildings.end());
+        __endDay(cursor.day);
+        cursor.read = 0;
+        cursor.write = 0;
+    }
+    return true;
+}
+
+void Scheduler::__endSchedule(__ScheduleCursor& cursor) {
+    bool completed = cursor.day >= WORK_DAYS;
+    if (!completed) {
+        // stopped in the middle of a day: the untried buildings stay, after the ones kept so far.
+        // Nothing to close when stopped between days, moving the buildings onto themselves would empty them
+        if (cursor.write != cursor.read) {
+            auto untried = __buildings.begin() + cursor.read;
+            auto kept_end = std::move(untried, __buildings.end(), __buildings.begin() + cursor.write);
+            __buildings.erase(kept_end, __buildings.end());
+            if (__diagnostics) {
+                auto untried_shortfalls = __building_shortfalls.begin() + cursor.read;
+                std::move(untried_shortfalls, __building_shortfalls.end(), __building_shortfalls.begin() + cursor.write);
+            }
+        }
+        __endDay(cursor.day);
+        cursor.read = 0;
+        cursor.write = 0;
+    }
+    if (__diagnostics) {
+        __buildCapacityReport();
+    }
+    __policy_heaps.clear();
+    __nearest_trees.clear();
+    // logged once the run is over, a cancelled run replays only as far as it got
+    if (__operation_log) {
+        if (completed) {
+            __operation_log->recordSchedule();
+        } else {
+            __operation_log->recordPartialSchedule(cursor.tried);
+        }
+    }
+}
+
+void Scheduler::__endDay(int day) {
+    if (__assignment_policy != AssignmentPolicy::GREEDY) {
+        __syncPoolsWithPolicy(day);
+    }
+    if (__diagnostics) {
+        __building_shortfalls.resize(__buildings.size());
+        for (int type = 0; type < EMPLOYEE_TYPES; type++) {
+            __available_at_end_of_day[day][type] = __availableCount(static_cast<EmployeeType>(type), day);
+        }
+    }
+}
+
+void Scheduler::__buildCapacityReport() {
+    __capacity_report = {};
+    std::array<std::array<int, EMPLOYEE_TYPES>, WORK_DAYS> required{};
+    for (std::size_t b = 0; b < __buildings.size(); b++) {
+        UnscheduledBuilding unscheduled{__buildings[b].name, __buildings[b].type, __building_shortfalls[b]};
+        for (int day = 0; day < WORK_DAYS; day++) {
+            const DayShortfall& shortfall = unscheduled.days[day];
+            if (shortfall.alternative >= 0 &&
+                (unscheduled.closestDay < 0 || shortfall.totalMissing() < unscheduled.days[unscheduled.closestDay].totalMissing())) {
+                unscheduled.closestDay = day;
             }
         }
+        if (unscheduled.closestDay >= 0) {
+            for (int type = 0; type < EMPLOYEE_TYPES; type++) {
+                required[unscheduled.closestDay][type] += unscheduled.days[unscheduled.closestDay].required[type];
+            }
+        }
+        __capacity_report.unscheduled.push_back(std::move(unscheduled));
     }
+    // buildings sharing a day compete for the same free employees, so the gap is taken on their total staff
+    for (int day = 0; day < WORK_DAYS; day++) {
+        for (int type = 0; type < EMPLOYEE_TYPES; type++) {
+            __capacity_report.gap[day][type] = std::max(0, required[day][type] - __available_at_end_of_day[day][type]);
+        }
+    }
+    __building_shortfalls.clear();
+}
+
+void Scheduler::setDiagnostics(const bool& enabled) {
+    __diagnostics = enabled;
+}
+
+const CapacityReport& Scheduler::getCapacityReport() const {
+    return __capacity_report;
 }
 
-bool Scheduler::__canBuild(const Building& building, int day, std::vector<int>& assignedEmployees) {
+ScheduleProgress Scheduler::__progressOf(const __ScheduleCursor& cursor) const {
+    //the slots between write and read hold the buildings scheduled on the current day
+    return ScheduleProgress{cursor.day, cursor.scheduled, __buildings.size() - (cursor.read - cursor.write)};
+}
+
+bool Scheduler::__canBuild(const Building& building, int day, std::vector<int>& assignedEmployees, DayShortfall* shortfall) {
 
-    auto conditions = buildingRequirements.equal_range(building.type);
+    auto conditions = __building_requirements->find(building.type);
+    if (conditions == __building_requirements->end() || conditions->second.empty()) {
+        return false; //no rule for this building type
+    }
     bool cond_met_so_far = true;
-    auto condition = (conditions.first)->second;
+    const RequirementAlternative_Type* condition = nullptr;
+    int alternative = 0;
 
-    for (auto it = conditions.first; it != conditions.second; ++it) {
+    for (const auto& candidate : conditions->second) {
         cond_met_so_far = true;
-        condition = it->second;
+        condition = &candidate;
+        DayShortfall examined;
         
-        for (const auto& [employeeType, employeeTypeCount] : condition) {
-            if (static_cast<int>(__employees_by_type_and_day[employeeType][day].size()) < employeeTypeCount) {
+        for (const auto& [employeeType, employeeTypeCount] : *condition) {
+            int available = __availableCount(employeeType, day);
+            if (available < employeeTypeCount) {
                 cond_met_so_far = false;
             }
-            if (!cond_met_so_far) {
+            if (shortfall) {
+                // keep going through the types, the counts are at hand anyway
+                examined.required[static_cast<int>(employeeType)] = employeeTypeCount;
+                examined.missing[static_cast<int>(employeeType)] = std::max(0, employeeTypeCount - available);
+            } else if (!cond_met_so_far) {
                 break;
             }
         }
@@ -91,15 +453,21 @@ bool Scheduler::__canBuild(const Building& building, int day, std::vector<int>&
         if (cond_met_so_far) {
             break;
         }
+        if (shortfall && (shortfall->alternative < 0 || examined.totalMissing() < shortfall->totalMissing())) {
+            examined.alternative = alternative;
+            *shortfall = examined;
+        }
+        alternative++;
     }
 
     if (cond_met_so_far) {
-        for (const auto& [employeeType, employeeTypeCount] : condition) {
+        for (const auto& [employeeType, employeeTypeCount] : *condition) {
             int workers_count = employeeTypeCount;
             while (workers_count > 0) {
-                Employee *emp = __employees_by_type_and_day[employeeType][day].back();
-                __employees_by_type_and_day[employeeType][day].pop_back();
+                Employee *emp = __takeEmployee(employeeType, day, building.location);
                 assignedEmployees.push_back(emp->id);
+                __travel_distance += travelDistance(emp->location, building.location);
+                __recordShift(emp, day);
                 workers_count--;
             }
         }
@@ -108,8 +476,210 @@ bool Scheduler::__canBuild(const Building& building, int day, std::vector<int>&
     return cond_met_so_far;
 }
 
+int Scheduler::__availableCount(const EmployeeType& empType, int day) {
+    if (__assignment_policy == AssignmentPolicy::GREEDY) {
+        return static_cast<int>(__employees_by_type_and_day[empType][day].size());
+    }
+    if (__assignment_policy == AssignmentPolicy::NEAREST) {
+        return static_cast<int>(__nearest_trees[empType][day].size());
+    }
+    return static_cast<int>(__policy_heaps[empType][day].size());
+}
+
+Employee* Scheduler::__takeEmployee(const EmployeeType& empType, int day, const Location& site) {
+    if (__assignment_policy == AssignmentPolicy::GREEDY) {
+        Employee *emp = __employees_by_type_and_day[empType][day].back();
+        __employees_by_type_and_day[empType][day].pop_back();
+        return emp;
+    }
+    // the day pool itself is synced once the day is over, see __syncPoolsWithPolicy
+    if (__assignment_policy == AssignmentPolicy::NEAREST) {
+        auto& tree = __nearest_trees[empType][day];
+        int nearest_id = tree.nearest(site);
+        tree.erase(nearest_id);
+        return &__employees_by_id[nearest_id];
+    }
+    return &__employees_by_id[__policy_heaps[empType][day].pop()];
+}
+
+void Scheduler::__recordShift(Employee* emp, int day) {
+    emp->assignedHours += SHIFT_HOURS;
+    emp->lastAssignment = __assignment_seq++;
+    bool capped = __weekly_hour_cap > 0 && emp->assignedHours + SHIFT_HOURS > __weekly_hour_cap;
+
+    if (__assignment_policy == AssignmentPolicy::NEAREST) {
+        if (capped) {
+            auto& trees = __nearest_trees[emp->type];
+            for (int later_day = day + 1; later_day < WORK_DAYS; later_day++) {
+                trees[later_day].erase(emp->id);
+            }
+        }
+    } else if (__assignment_policy != AssignmentPolicy::GREEDY) {
+        auto& heaps = __policy_heaps[emp->type];
+        for (int later_day = day + 1; later_day < WORK_DAYS; later_day++) {
+            if (!heaps[later_day].contains(emp->id)) {
+                continue;
+            }
+            if (capped) {
+                heaps[later_day].erase(emp->id);
+            } else {
+                heaps[later_day].update(emp->id, __policyKey(*emp, std::get<2>(heaps[later_day].keyOf(emp->id))));
+            }
+        }
+    }
+}
+
+void Scheduler::__dropCapped(int day) {
+    if (__weekly_hour_cap <= 0) {
+        return;
+    }
+    for (auto& [empType, pools] : __employees_by_type_and_day) {
+        std::erase_if(pools[day], [&](Employee *emp) { return emp->assignedHours + SHIFT_HOURS > __weekly_hour_cap; });
+    }
+}
+
+Scheduler::__PolicyKey_Type Scheduler::__policyKey(const Employee& emp, int poolPosition) const {
+    if (__assignment_policy == AssignmentPolicy::LEAST_ASSIGNED) {
+        return {emp.assignedHours, emp.lastAssignment, poolPosition};
+    }
+    return {0, emp.lastAssignment, poolPosition};
+}
+
+void Scheduler::__buildPolicyHeaps() {
+    __policy_heaps.clear();
+    for (const auto& [empType, pools] : __employees_by_type_and_day) {
+        auto& heaps = __policy_heaps[empType];
+        for (int day = 0; day < WORK_DAYS; day++) {
+            const auto& pool = pools[day];
+            int pool_size = static_cast<int>(pool.size());
+            for (int pos = 0; pos < pool_size; pos++) {
+                // ties go to the back of the pool, like the greedy policy
+                if (heaps[day].contains(pool[pos]->id)) {
+                    continue;
+                }
+                heaps[day].push(pool[pos]->id, __policyKey(*pool[pos], pool_size - 1 - pos));
+            }
+        }
+    }
+}
+
+void Scheduler::__buildNearestTrees() {
+    __nearest_trees.clear();
+    for (const auto& [empType, pools] : __employees_by_type_and_day) {
+        auto& trees = __nearest_trees[empType];
+        for (int day = 0; day < WORK_DAYS; day++) {
+            std::vector<std::pair<int, Location>> points;
+            points.reserve(pools[day].size());
+            for (const Employee *emp : pools[day]) {
+                points.push_back(make_pair(emp->id, emp->location));
+            }
+            trees[day] = KdTree(std::move(points));
+        }
+    }
+}
+
+void Scheduler::__syncPoolsWithPolicy(int day) {
+    for (auto& [empType, pools] : __employees_by_type_and_day) {
+        if (__assignment_policy == AssignmentPolicy::NEAREST) {
+            const auto& tree = __nearest_trees[empType][day];
+            std::erase_if(pools[day], [&](Employee *emp) { return !tree.contains(emp->id); });
+        } else {
+            const auto& heap = __policy_heaps[empType][day];
+            std::erase_if(pools[day], [&](Employee *emp) { return !heap.contains(emp->id); });
+        }
+    }
+}
+
 void Scheduler::__assignEmployees(const Building& building, int day, const std::vector<int>& assignedEmployees) {
+    int building_id = __internBuildingName(building.name);
+    __schedule_slot_by_building[building_id] = make_pair(day, static_cast<int>(__daily_schedule[day].size()));
     __daily_schedule[day].push_back(make_pair(building.name, assignedEmployees));
+
+    std::string_view interned_name = __building_names[building_id];
+    for (const auto& empId : assignedEmployees) {
+        __assignments_by_employee[empId].push_back(EmployeeAssignment{day, interned_name});
+    }
+}
+
+int Scheduler::__internBuildingName(const std::string& buildName) {
+    auto found = __building_id_by_name.find(buildName);
+    if (found != __building_id_by_name.end()) {
+        return found->second;
+    }
+    int building_id = static_cast<int>(__building_names.size());
+    __building_names.push_back(buildName);  //deque keeps the earlier strings in place, so the views stay valid
+    __building_id_by_name[__building_names.back()] = building_id;
+    __schedule_slot_by_building.push_back(make_pair(-1, -1));
+    return building_id;
+}
+
+std::span<const EmployeeAssignment> Scheduler::getEmployeeAssignments(const int& employeeId) const {
+    auto found = __assignments_by_employee.find(employeeId);
+    if (found == __assignments_by_employee.end()) {
+        return {};
+    }
+    return found->second;
+}
+
+std::optional<BuildingAssignment> Scheduler::getBuildingAssignment(const std::string_view& buildName) const {
+    auto found = __building_id_by_name.find(buildName);
+    if (found == __building_id_by_name.end()) {
+        return std::nullopt;
+    }
+    const auto& [day, position] = __schedule_slot_by_building[found->second];
+    if (day < 0) {
+        return std::nullopt; //added, not scheduled yet
+    }
+    return BuildingAssignment{day, __daily_schedule[day][position].second};
+}
+
+MemoryUsage Scheduler::memoryUsage() const {
+    MemoryUsage usage;
+    usage.employees = heapBytes(__employees_by_id);
+    for (const auto& [employeeId, employee] : __employees_by_id) {
+        usage.employees += heapBytes(employee.availability);
+    }
+    usage.availabilityPools = heapBytes(__employees_by_type_and_day);
+    for (const auto& [employeeType, pools] : __employees_by_type_and_day) {
+        for (const auto& pool : pools) {
+            usage.availabilityPools += heapBytes(pool);
+        }
+    }
+    usage.buildings = heapBytes(__buildings);
+    for (const auto& building : __buildings) {
+        usage.buildings += heapBytes(building.name);
+    }
+    for (const auto& entries : __daily_schedule) {
+        usage.schedule += heapBytes(entries);
+        for (const auto& [buildName, crew] : entries) {
+            usage.schedule += heapBytes(buildName) + heapBytes(crew);
+        }
+    }
+    usage.indices = __building_names.size() * sizeof(std::string) + heapBytes(__building_id_by_name) + heapBytes(__schedule_slot_by_building)
+                    + heapBytes(__assignments_by_employee);
+    for (const auto& name : __building_names) {
+        usage.indices += heapBytes(name);
+    }
+    for (const auto& [employeeId, assignments] : __assignments_by_employee) {
+        usage.indices += heapBytes(assignments);
+    }
+    // the heaps and trees are emptied once a run is over, what is left is the bucket arrays of their maps
+    usage.indices += heapBytes(__policy_heaps) + heapBytes(__nearest_trees);
+    for (const auto& [employeeType, heaps] : __policy_heaps) {
+        for (const auto& heap : heaps) {
+            usage.indices += heap.heapBytes();
+        }
+    }
+    for (const auto& [employeeType, trees] : __nearest_trees) {
+        for (const auto& tree : trees) {
+            usage.indices += tree.heapBytes();
+        }
+    }
+    usage.diagnostics = heapBytes(__building_shortfalls) + heapBytes(__capacity_report.unscheduled);
+    for (const auto& unscheduled : __capacity_report.unscheduled) {
+        usage.diagnostics += heapBytes(unscheduled.name);
+    }
+    return usage;
 }
 
 void Scheduler::printSchedule() const {
@@ -132,6 +702,9 @@ const Scheduler::__DailySchedule_Type& Scheduler::getSchedule() const {
 }
 
 void Scheduler::updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability) {
+    if (__operation_log) {
+        __operation_log->recordUpdateAvailability(employeeId, newAvailability);
+    }
     for (DayOfWeek day = DayOfWeek::MONDAY; static_cast<int>(day) < WORK_DAYS; ++day) {
         int int_day = static_cast<int>(day);
         bool future_avail = newAvailability[int_day];
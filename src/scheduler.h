@@ -4,27 +4,131 @@
 #include <array>
 #include <unordered_map>
 #include <utility>
+#include <tuple>
+#include <deque>
+#include <span>
+#include <string_view>
+#include <optional>
+#include <functional>
+#include <future>
+#include <stop_token>
+#include <cstddef>
+#include <memory>
 #include "employee.h"
 #include "building.h"
 #include "days.h"
+#include "indexed_min_heap.h"
+#include "kd_tree.h"
+#include "memory_usage.h"
+#include "capacity_report.h"
+#include "building_requirements.h"
+
+constexpr int SHIFT_HOURS=8;
+
+// how the workers of a crew are picked among the available employees of the required type
+enum class AssignmentPolicy {
+    GREEDY,          //the employee added last, the original behavior
+    LEAST_ASSIGNED,  //the employee with the fewest assigned hours, least recently assigned on ties
+    ROUND_ROBIN,     //the least recently assigned employee
+    NEAREST          //the employee closest to the building
+};
+
+class OperationLog;
+
+// where an employee works on a day, the building name views the scheduler's interned copy
+struct EmployeeAssignment {
+    int day;
+    std::string_view building;
+};
+
+// when a building is built and by whom, the crew views the schedule entry
+struct BuildingAssignment {
+    int day;
+    std::span<const int> crew;
+};
+
+
+// buildings scheduled on each work day, with the ids of their crews
+using Schedule_Type = std::array<std::vector<std::pair<std::string, std::vector<int>>>, WORK_DAYS>;
+
+// how far a scheduleAsync run got, reported after every chunk
+struct ScheduleProgress {
+    int day;                       //day being scheduled, WORK_DAYS once the run is over
+    std::size_t buildingsScheduled; //by this run so far
+    std::size_t buildingsPending;   //not scheduled yet
+};
+
+enum class ScheduleStatus {
+    COMPLETED,
+    CANCELLED  //stopped through the stop token, the schedule holds what was placed until then
+};
+
+using ScheduleExecutor_Type = std::function<void(std::function<void()>)>; //runs the given task, now or later, on any thread
+using ScheduleProgressCallback_Type = std::function<void(const ScheduleProgress&)>;
+constexpr std::size_t DEFAULT_SCHEDULE_CHUNK = 256; //buildings tried per executor task
 
 
 class Scheduler {
     public:
-        using BuildingRequrement_Type = std::unordered_multimap<BuildingType,
-                                            std::vector<
-                                                std::pair<EmployeeType, int>
-                                                >
+        using RequirementAlternative_Type = std::vector<std::pair<EmployeeType, int>>; //staff count by employee type
+        using BuildingRequrement_Type = std::unordered_map<BuildingType,
+                                            std::vector<RequirementAlternative_Type> //tried in order, the first one staffed wins
                                             >;
-        static BuildingRequrement_Type buildingRequirements; //the conditions for each building
+        // the conditions for each building, built from defaultBuildingRequirements; before the vector of alternatives this was
+        // an unordered_multimap with one entry per alternative. A building type without an entry is left unscheduled.
+        static BuildingRequrement_Type buildingRequirements;
+        static BuildingRequrement_Type requirementsFrom(std::span<const StaticRequirement<EMPLOYEE_TYPES>> table); //keeps the table order
+        // the first alternative for the building type that availableOf(employeeType) free employees can staff, nullptr if none,
+        // for the schedulers keeping their own pools
+        template <typename AvailableOf>
+        static const RequirementAlternative_Type* staffableAlternative(const BuildingRequrement_Type& requirements,
+                                                                       const BuildingType& buildType, AvailableOf&& availableOf);
         Scheduler();
+        // copies rebind the pools and the assignment views to their own state; the copy starts without an operation log
+        Scheduler(const Scheduler& other);
+        Scheduler(Scheduler&& other) = default; //the moved nodes and strings keep their addresses, the views stay valid
+        Scheduler& operator=(const Scheduler& other);
+        Scheduler& operator=(Scheduler&& other) = default;
+        // rules used instead of buildingRequirements, e.g. per tenant, schedulers may share them; nullptr restores the default
+        void setBuildingRequirements(std::shared_ptr<const BuildingRequrement_Type> requirements);
+        std::shared_ptr<const BuildingRequrement_Type> getBuildingRequirements() const; //never null, the default table unless set
         void schedule();
+        // same as schedule(), split in tasks of at most chunkSize buildings posted one after the other to the executor.
+        // The stop token is checked between tasks; the scheduler must not be used until the future is ready.
+        std::future<ScheduleStatus> scheduleAsync(const ScheduleExecutor_Type& executor, std::stop_token stopToken = {},
+                                                  const ScheduleProgressCallback_Type& onProgress = {},
+                                                  std::size_t chunkSize = DEFAULT_SCHEDULE_CHUNK);
         void printSchedule() const; //a function to get the schedule for the unit tests is needed,
                                     // but for now just using the print and manual inspection
-        const std::array<std::vector<std::pair<std::string, std::vector<int>>>, WORK_DAYS>& getSchedule() const;
+        const Schedule_Type& getSchedule() const;
         void updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability);
-        void addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability);
-        void addBuilding(const std::string& buildName, const BuildingType& buildType);
+        // the same id again replaces the employee, its type and availability included
+        void addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability, const Location& empLocation = {});
+        // building names are unique, the same name again throws std::invalid_argument
+        void addBuilding(const std::string& buildName, const BuildingType& buildType, const Location& buildLocation = {});
+        void setAssignmentPolicy(const AssignmentPolicy& policy);
+        // employees are not assigned beyond the cap, 0 means no cap; one cap for every employee, not a cap per employee
+        void setWeeklyHourCap(const int& hours);
+        // starts a new week for the cap: every employee's assigned hours go back to 0, the rotation order is kept.
+        // Like the employees assigned last week, the ones dropped for the cap are offered again through updateAvailability.
+        void startWeek();
+        int getAssignedHours(const int& employeeId) const;
+        double getTravelDistance() const; //total distance from the assigned employees to their buildings
+        // every later call is appended to the log, nullptr stops logging. Attached to a scheduler that isn't empty, the log
+        // first records its rules and a snapshot of its state, so a replay into a new scheduler starts from the same point
+        void setOperationLog(OperationLog* log);
+        OperationLog* getOperationLog() const;
+        // lookups on the indices maintained while scheduling, the results stay valid until the next schedule()
+        std::span<const EmployeeAssignment> getEmployeeAssignments(const int& employeeId) const;
+        std::optional<BuildingAssignment> getBuildingAssignment(const std::string_view& buildName) const;
+        MemoryUsage memoryUsage() const;
+        // records why buildings can't be staffed while scheduling, at the cost of checking every type of each alternative
+        void setDiagnostics(const bool& enabled);
+        const CapacityReport& getCapacityReport() const; //of the last schedule() run with diagnostics on
+        // Compact byte form of the roster, the buildings left and the schedule, see scheduler_snapshot.cpp.
+        // Rules, operation log and capacity report are not part of it; loading keeps the current ones.
+        std::string saveSnapshot() const;
+        void loadSnapshot(std::string_view bytes); //replaces the state, throws std::runtime_error on malformed input
 
     private:
         using __EmployeeAvailabilityByTypeAndDay_Type = std::unordered_map<EmployeeType, 
@@ -37,14 +141,88 @@ class Scheduler {
                                                     std::pair<std::string, std::vector<int>>
                                                 >
                                             , WORK_DAYS>;
+        // position of a schedule run, buildings before read were tried on day, the ones kept are packed before write
+        struct __ScheduleCursor {
+            int day;
+            std::size_t read;
+            std::size_t write;
+            std::size_t scheduled;
+            std::size_t tried; //buildings tried by the run over all days, the point a cancelled run is replayed to
+        };
+        struct __AsyncRun; //state of a scheduleAsync run, shared by its tasks
+        using __PolicyKey_Type = std::tuple<int, long long, int>; //(assigned hours, last assignment, position in the day pool)
+        using __PolicyHeapsByTypeAndDay_Type = std::unordered_map<EmployeeType,
+                                                    std::array<
+                                                        IndexedMinHeap<__PolicyKey_Type>
+                                                    , WORK_DAYS>
+                                                >;
+        using __NearestTreesByTypeAndDay_Type = std::unordered_map<EmployeeType,
+                                                    std::array<
+                                                        KdTree
+                                                    , WORK_DAYS>
+                                                >;
 
         std::vector<Building> __buildings;
         std::unordered_map<int, Employee> __employees_by_id; //access employees by ID
         __EmployeeAvailabilityByTypeAndDay_Type __employees_by_type_and_day; //access available employees reference filtered by type and day,
                                                                              // employee ref points to employees in __employees_by_id
         __DailySchedule_Type __daily_schedule; // array of weekdays, each holding the name of the building(s) and the list of employees to work on it
+        AssignmentPolicy __assignment_policy;
+        int __weekly_hour_cap;
+        long long __assignment_seq; //increases with every assigned shift, orders the assignments for ROUND_ROBIN
+        __PolicyHeapsByTypeAndDay_Type __policy_heaps; //available employees ordered by the policy, used by LEAST_ASSIGNED and ROUND_ROBIN
+        __NearestTreesByTypeAndDay_Type __nearest_trees; //available employees indexed by location, used by NEAREST
+        double __travel_distance;
+        std::deque<std::string> __building_names; //interned names of the added buildings, the index is the building id
+        std::unordered_map<std::string_view, int> __building_id_by_name; //keys view the strings in __building_names
+        std::vector<std::pair<int, int>> __schedule_slot_by_building; //building id -> (day, position in __daily_schedule[day]), (-1, -1) until scheduled
+        std::unordered_map<int, std::vector<EmployeeAssignment>> __assignments_by_employee; //employee id -> days worked, in schedule order
+        OperationLog* __operation_log; //not owned
+        bool __diagnostics;
+        std::vector<std::array<DayShortfall, WORK_DAYS>> __building_shortfalls; //parallel to __buildings during a diagnosed run
+        std::array<std::array<int, EMPLOYEE_TYPES>, WORK_DAYS> __available_at_end_of_day; //free employees by type once each day is done
+        CapacityReport __capacity_report;
+        std::shared_ptr<const BuildingRequrement_Type> __building_requirements; //buildingRequirements unless set
 
-        bool __canBuild(const Building& building, int day, std::vector<int>& assignedEmployees); //Checks if a building can be built on a given day and fill the assigned employees vector
+        __ScheduleCursor __beginSchedule();
+        bool __scheduleChunk(__ScheduleCursor& cursor, std::size_t maxBuildings); //true once every day is done
+        void __endSchedule(__ScheduleCursor& cursor); //also closes a run stopped in the middle of a day, then logs the run
+        ScheduleProgress __progressOf(const __ScheduleCursor& cursor) const;
+        bool __canBuild(const Building& building, int day, std::vector<int>& assignedEmployees, DayShortfall* shortfall = nullptr); //Checks if a building can be built on a given day and fill the assigned employees vector,
+                                                                                                                                   // fills the shortfall when it can't and one is given
+        void __endDay(int day);
+        void __buildCapacityReport();
         void __assignEmployees(const Building& building, int day, const std::vector<int>& assignedEmployees); //add the building and the assigned employees for that day to the schedule
         void __addEmployeeToAvailByTypeAndDay(const EmployeeType& empType, const int& employeeId, const std::vector<bool>& empAvailability);
+        int __availableCount(const EmployeeType& empType, int day);
+        Employee* __takeEmployee(const EmployeeType& empType, int day, const Location& site); //removes the next employee to assign from the day pool
+        void __recordShift(Employee* emp, int day); //accounts the hours and drops the employee from the later heaps or trees once capped
+        void __dropCapped(int day); //one pass over the day pools, instead of an erase per capped employee
+        __PolicyKey_Type __policyKey(const Employee& emp, int poolPosition) const;
+        void __buildPolicyHeaps();
+        void __buildNearestTrees();
+        void __syncPoolsWithPolicy(int day);
+        int __internBuildingName(const std::string& buildName);
 };
+
+template <typename AvailableOf>
+const Scheduler::RequirementAlternative_Type* Scheduler::staffableAlternative(const BuildingRequrement_Type& requirements,
+                                                                              const BuildingType& buildType, AvailableOf&& availableOf) {
+    auto conditions = requirements.find(buildType);
+    if (conditions == requirements.end()) {
+        return nullptr;
+    }
+    for (const auto& alternative : conditions->second) {
+        bool cond_met_so_far = true;
+        for (const auto& [employeeType, employeeTypeCount] : alternative) {
+            if (static_cast<int>(availableOf(employeeType)) < employeeTypeCount) {
+                cond_met_so_far = false;
+                break;
+            }
+        }
+        if (cond_met_so_far) {
+            return &alternative;
+        }
+    }
+    return nullptr;
+}
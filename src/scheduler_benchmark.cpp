@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <type_traits>
+#include <filesystem>
+#include <memory>
+#include "scheduler.h"
+#include "static_scheduler.h"
+#include "compact_scheduler.h"
+#include "operation_log.h"
+#include "schedule_diff.h"
+#include "scheduler_invariants.h"
+
+namespace {
+
+// same seed for both schedulers, so they see identical inputs
+Workload makeWorkload(int buildingCount, int employeeCount) {
+    std::mt19937 rng(42);
+    return randomWorkload(rng, buildingCount, employeeCount, 0, 0.7);
+}
+
+template <typename SchedulerT>
+void load(SchedulerT& scheduler, const Workload& workload, const AssignmentPolicy& policy) {
+    if constexpr (std::is_same_v<SchedulerT, Scheduler>) {
+        scheduler.setAssignmentPolicy(policy);
+    }
+    loadWorkload(scheduler, workload);
+}
+
+template <typename SchedulerT, AssignmentPolicy Policy = AssignmentPolicy::GREEDY>
+void BM_Schedule(benchmark::State& state) {
+    const Workload workload = makeWorkload(state.range(0), state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        SchedulerT scheduler;
+        load(scheduler, workload, Policy);
+        state.ResumeTiming();
+
+        scheduler.schedule();
+        benchmark::DoNotOptimize(scheduler.getSchedule());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// loads and schedules once, reports the footprint of the scheduled state per employee
+template <typename SchedulerT>
+void BM_MemoryFootprint(benchmark::State& state) {
+    const Workload workload = makeWorkload(state.range(0), state.range(1));
+    MemoryUsage usage;
+    for (auto _ : state) {
+        SchedulerT scheduler;
+        load(scheduler, workload, AssignmentPolicy::GREEDY);
+        if constexpr (std::is_same_v<SchedulerT, CompactScheduler>) {
+            scheduler.shrinkToFit();
+        }
+        scheduler.schedule();
+        usage = scheduler.memoryUsage();
+    }
+    state.counters["bytes"] = usage.total();
+    state.counters["bytes_per_employee"] = static_cast<double>(usage.employees + usage.availabilityPools) / state.range(1);
+}
+
+// diff and encoding of two runs that differ by one availability update
+void BM_ScheduleDiff(benchmark::State& state) {
+    const Workload workload = makeWorkload(state.range(0), state.range(1));
+    Scheduler scheduler;
+    Scheduler rescheduled;
+    load(scheduler, workload, AssignmentPolicy::GREEDY);
+    load(rescheduled, workload, AssignmentPolicy::GREEDY);
+    scheduler.schedule();
+    const Employee& sick = workload.employees.back();
+    rescheduled.updateAvailability(sick.id, std::vector<bool>(WORK_DAYS, false));
+    rescheduled.schedule();
+
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        bytes = serializeDelta(diff(scheduler.getSchedule(), rescheduled.getSchedule())).size();
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["delta_bytes"] = bytes;
+}
+
+// availability updates on a loaded scheduler, with and without the operation log, to see the logging overhead
+template <bool Logged>
+void BM_UpdateAvailability(benchmark::State& state) {
+    const Workload workload = makeWorkload(state.range(0), state.range(1));
+    const std::string path = (std::filesystem::temp_directory_path() / "scheduler_benchmark.log").string();
+    std::filesystem::remove(path);
+    std::unique_ptr<OperationLog> log = Logged ? std::make_unique<OperationLog>(path) : nullptr;
+
+    Scheduler scheduler;
+    for (const auto& employee : workload.employees) {
+        scheduler.addEmployee(employee.id, employee.type, employee.availability);
+    }
+    scheduler.setOperationLog(log.get());
+
+    std::size_t next = 0;
+    for (auto _ : state) {
+        const Employee& employee = workload.employees[next];
+        scheduler.updateAvailability(employee.id, employee.availability);
+        next = (next + 1) % workload.employees.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    scheduler.setOperationLog(nullptr);
+    log.reset();
+    std::filesystem::remove(path);
+}
+
+}
+
+BENCHMARK(BM_Schedule<Scheduler>)->Name("BM_DynamicScheduler")->Args({100, 50})->Args({1000, 500})->Args({10000, 5000});
+BENCHMARK(BM_Schedule<DefaultStaticScheduler>)->Name("BM_StaticScheduler")->Args({100, 50})->Args({1000, 500})->Args({10000, 5000});
+BENCHMARK(BM_Schedule<CompactScheduler>)->Name("BM_CompactScheduler")->Args({100, 50})->Args({1000, 500})->Args({10000, 5000});
+BENCHMARK(BM_Schedule<Scheduler, AssignmentPolicy::LEAST_ASSIGNED>)->Name("BM_LeastAssignedScheduler")->Args({100, 50})->Args({1000, 500})->Args({10000, 5000});
+BENCHMARK(BM_Schedule<Scheduler, AssignmentPolicy::NEAREST>)->Name("BM_NearestScheduler")->Args({100, 50})->Args({1000, 500})->Args({10000, 5000});
+BENCHMARK(BM_ScheduleDiff)->Args({1000, 500})->Args({10000, 5000});
+BENCHMARK(BM_MemoryFootprint<Scheduler>)->Name("BM_DynamicFootprint")->Args({10000, 100000})->Iterations(1);
+BENCHMARK(BM_MemoryFootprint<CompactScheduler>)->Name("BM_CompactFootprint")->Args({10000, 100000})->Iterations(1);
+BENCHMARK(BM_UpdateAvailability<false>)->Name("BM_UpdateAvailability")->Args({0, 5000});
+BENCHMARK(BM_UpdateAvailability<true>)->Name("BM_UpdateAvailabilityLogged")->Args({0, 5000});
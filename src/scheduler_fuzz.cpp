@@ -0,0 +1,50 @@
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+#include "scheduler_invariants.h"
+
+// libFuzzer entry point: build with -fsanitize=fuzzer and -DSCHEDULER_FUZZ_LIBFUZZER (bazel --config=fuzz)
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    auto violations = checkWorkload(workloadFromBytes(data, size));
+    if (!violations.empty()) {
+        for (const auto& violation : violations) {
+            std::cerr << violation << std::endl;
+        }
+        std::abort();
+    }
+    return 0;
+}
+
+#ifndef SCHEDULER_FUZZ_LIBFUZZER
+// offline driver: replays the given corpus files, or random inputs when none are given
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        for (int arg = 1; arg < argc; arg++) {
+            std::ifstream input(argv[arg], std::ios::binary);
+            std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+        return 0;
+    }
+
+    unsigned seed = std::random_device{}();
+    std::cout << "random inputs from seed " << seed << std::endl;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> size_dist(0, 4096);
+    std::uniform_int_distribution<int> byte_dist(0, 255);
+    for (int run = 0; run < 2000; run++) {
+        std::vector<std::uint8_t> data(size_dist(rng));
+        for (auto& byte : data) {
+            byte = static_cast<std::uint8_t>(byte_dist(rng));
+        }
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    std::cout << "2000 random inputs passed" << std::endl;
+    return 0;
+}
+#endif
@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <deque>
+#include <functional>
+#include <stop_token>
+
+#include "scheduler_invariants.h"
+#include "static_scheduler.h"
+#include "compact_scheduler.h"
+#include "rolling_scheduler.h"
+
+using namespace std;
+
+namespace {
+
+using Schedule_Type = array<vector<pair<string, vector<int>>>, WORK_DAYS>;
+
+// building -> day, the part of the schedule that does not depend on which employee of a type is picked
+map<string, int> daysByBuilding(const Schedule_Type& schedule) {
+    map<string, int> days;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        for (const auto& [building, crew] : schedule[day]) {
+            days[building] = day;
+        }
+    }
+    return days;
+}
+
+void checkSchedule(const string& label, const Workload& workload, const Schedule_Type& schedule, vector<string>& violations) {
+    unordered_map<string, BuildingType> type_by_building;
+    for (const Building& building : workload.buildings) {
+        type_by_building[building.name] = building.type;
+    }
+    unordered_map<int, Employee> employee_by_id;
+    for (const auto& employee : workload.employees) {
+        employee_by_id[employee.id] = employee;
+    }
+    for (const auto& [employeeId, availability] : workload.availabilityUpdates) {
+        employee_by_id[employeeId].availability = availability;
+    }
+
+    set<string> scheduled_buildings;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        set<int> booked;
+        for (const auto& [building, crew] : schedule[day]) {
+            string where = label + ": " + dayToStr.at(static_cast<DayOfWeek>(day)) + " " + building;
+            if (!scheduled_buildings.insert(building).second) {
+                violations.push_back(where + " is scheduled more than once");
+            }
+            auto building_type = type_by_building.find(building);
+            if (building_type == type_by_building.end()) {
+                violations.push_back(where + " was never added");
+                continue;
+            }
+
+            array<int, EMPLOYEE_TYPES> crew_by_type{};
+            for (const auto& empId : crew) {
+                if (!booked.insert(empId).second) {
+                    violations.push_back(where + " double-books employee " + to_string(empId));
+                }
+                auto employee = employee_by_id.find(empId);
+                if (employee == employee_by_id.end()) {
+                    violations.push_back(where + " assigns unknown employee " + to_string(empId));
+                    continue;
+                }
+                if (!employee->second.availability[day]) {
+                    violations.push_back(where + " assigns unavailable employee " + to_string(empId));
+                }
+                crew_by_type[static_cast<int>(employee->second.type)]++;
+            }
+
+            bool staffs_alternative = false;
+            auto conditions = Scheduler::buildingRequirements.find(building_type->second);
+            for (size_t a = 0; conditions != Scheduler::buildingRequirements.end() && a < conditions->second.size() && !staffs_alternative; a++) {
+                array<int, EMPLOYEE_TYPES> needed{};
+                for (const auto& [employeeType, employeeTypeCount] : conditions->second[a]) {
+                    needed[static_cast<int>(employeeType)] += employeeTypeCount;
+                }
+                staffs_alternative = needed == crew_by_type;
+            }
+            if (!staffs_alternative) {
+                violations.push_back(where + " crew matches no requirement alternative");
+            }
+        }
+    }
+}
+
+void checkIndices(const string& label, const Scheduler& scheduler, vector<string>& violations) {
+    const auto& schedule = scheduler.getSchedule();
+    for (int day = 0; day < WORK_DAYS; day++) {
+        for (const auto& [building, crew] : schedule[day]) {
+            auto assignment = scheduler.getBuildingAssignment(building);
+            if (!assignment || assignment->day != day || !equal(crew.begin(), crew.end(), assignment->crew.begin(), assignment->crew.end())) {
+                violations.push_back(label + ": building index disagrees for " + building);
+            }
+            for (const auto& empId : crew) {
+                auto worked = scheduler.getEmployeeAssignments(empId);
+                bool found = any_of(worked.begin(), worked.end(), [&](const EmployeeAssignment& a) {
+                    return a.day == day && a.building == building;
+                });
+                if (!found) {
+                    violations.push_back(label + ": employee index misses " + to_string(empId) + " on " + building);
+                }
+            }
+        }
+    }
+}
+
+// tasks posted by scheduleAsync, run one after the other once the run is started
+struct TaskQueue {
+    deque<function<void()>> tasks;
+
+    ScheduleExecutor_Type executor() {
+        return [this](function<void()> task) { tasks.push_back(std::move(task)); };
+    }
+    void drain() {
+        while (!tasks.empty()) {
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            task();
+        }
+    }
+};
+
+}
+
+Workload randomWorkload(mt19937& rng, int buildingCount, int employeeCount, int updateCount, optional<double> availabilityRate) {
+    Workload workload;
+    uniform_int_distribution<int> type_dist(0, 2);
+    if (!availabilityRate) {
+        availabilityRate = uniform_real_distribution<double>(0.2, 0.9)(rng);
+    }
+    bernoulli_distribution avail_dist(*availabilityRate);
+    uniform_real_distribution<double> coordinate_dist(0.0, 50.0);
+
+    auto randomAvailability = [&] {
+        vector<bool> availability(WORK_DAYS);
+        for (int day = 0; day < WORK_DAYS; day++) {
+            availability[day] = avail_dist(rng);
+        }
+        return availability;
+    };
+
+    for (int b = 0; b < buildingCount; b++) {
+        BuildingType type = static_cast<BuildingType>(type_dist(rng));
+        workload.buildings.push_back({"Build " + to_string(b), type, {coordinate_dist(rng), coordinate_dist(rng)}});
+    }
+    for (int id = 1; id <= employeeCount; id++) {
+        workload.employees.push_back({id, static_cast<EmployeeType>(type_dist(rng)), randomAvailability()});
+        workload.employees.back().location = {coordinate_dist(rng), coordinate_dist(rng)};
+    }
+    if (employeeCount > 0) {
+        uniform_int_distribution<int> id_dist(1, employeeCount);
+        for (int u = 0; u < updateCount; u++) {
+            workload.availabilityUpdates.push_back(make_pair(id_dist(rng), randomAvailability()));
+        }
+    }
+    return workload;
+}
+
+Workload workloadFromBytes(const uint8_t* data, size_t size) {
+    size_t pos = 0;
+    auto next = [&]() -> uint8_t { return pos < size ? data[pos++] : 0; };
+    auto availabilityOf = [](uint8_t bits) {
+        vector<bool> availability(WORK_DAYS);
+        for (int day = 0; day < WORK_DAYS; day++) {
+            availability[day] = (bits >> day) & 1;
+        }
+        return availability;
+    };
+
+    Workload workload;
+    int employee_count = next();
+    int building_count = next();
+    for (int id = 1; id <= employee_count; id++) {
+        uint8_t type = next();
+        workload.employees.push_back({id, static_cast<EmployeeType>(type % EMPLOYEE_TYPES), availabilityOf(next())});
+        workload.employees.back().location = {static_cast<double>(type / EMPLOYEE_TYPES), static_cast<double>(next())};
+    }
+    for (int b = 0; b < building_count; b++) {
+        uint8_t type = next();
+        Location location = {static_cast<double>(type / BUILDING_TYPES), static_cast<double>(next())};
+        workload.buildings.push_back({"Build " + to_string(b), static_cast<BuildingType>(type % BUILDING_TYPES), location});
+    }
+    while (employee_count > 0 && pos + 1 < size) {
+        int id = next() % employee_count + 1;
+        workload.availabilityUpdates.push_back(make_pair(id, availabilityOf(next())));
+    }
+    return workload;
+}
+
+vector<string> checkWorkload(const Workload& workload) {
+    vector<string> violations;
+
+    Scheduler reference;
+    loadWorkload(reference, workload);
+    reference.schedule();
+    checkSchedule("greedy", workload, reference.getSchedule(), violations);
+    checkIndices("greedy", reference, violations);
+
+    const auto reference_days = daysByBuilding(reference.getSchedule());
+
+    CompactScheduler compact;
+    loadWorkload(compact, workload);
+    compact.schedule();
+    if (compact.getSchedule() != reference.getSchedule()) {
+        violations.push_back("compact: schedule differs from the reference");
+    }
+
+    // in chunks of 3 buildings, then cancelled after the second chunk and finished by schedule()
+    Scheduler chunked;
+    loadWorkload(chunked, workload);
+    TaskQueue queue;
+    auto completed = chunked.scheduleAsync(queue.executor(), {}, {}, 3);
+    queue.drain();
+    if (completed.get() != ScheduleStatus::COMPLETED || chunked.getSchedule() != reference.getSchedule()) {
+        violations.push_back("async: schedule differs from the reference");
+    }
+    Scheduler cancelled;
+    loadWorkload(cancelled, workload);
+    stop_source deadline;
+    int chunks = 0;
+    auto stopped = cancelled.scheduleAsync(queue.executor(), deadline.get_token(), [&](const ScheduleProgress&) {
+        if (++chunks == 2) {
+            deadline.request_stop();
+        }
+    }, 3);
+    queue.drain();
+    stopped.get();
+    checkSchedule("cancelled", workload, cancelled.getSchedule(), violations);
+    checkIndices("cancelled", cancelled, violations);
+    for (const auto& [building, day] : daysByBuilding(cancelled.getSchedule())) {
+        if (reference_days.at(building) != day) {
+            violations.push_back("cancelled: " + building + " scheduled on another day than the reference");
+        }
+    }
+    cancelled.schedule();
+    if (cancelled.getSchedule() != reference.getSchedule()) {
+        violations.push_back("cancelled: resumed schedule differs from the reference");
+    }
+
+    // the open days of a new rolling scheduler are the work days of the week
+    RollingScheduler rolling;
+    loadWorkload(rolling, workload);
+    rolling.schedule();
+    Schedule_Type rolling_schedule;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        rolling_schedule[day] = rolling.getDaySchedule(day);
+    }
+    checkSchedule("rolling", workload, rolling_schedule, violations);
+    if (daysByBuilding(rolling_schedule) != reference_days) {
+        violations.push_back("rolling: buildings scheduled on other days than the reference");
+    }
+
+    // a snapshot taken before scheduling schedules the same, one taken after restores the schedule and the indices
+    Scheduler unscheduled;
+    loadWorkload(unscheduled, workload);
+    Scheduler restored;
+    restored.loadSnapshot(unscheduled.saveSnapshot());
+    restored.schedule();
+    if (restored.getSchedule() != reference.getSchedule()) {
+        violations.push_back("snapshot: restored roster schedules differently from the reference");
+    }
+    restored.loadSnapshot(reference.saveSnapshot());
+    if (restored.getSchedule() != reference.getSchedule()) {
+        violations.push_back("snapshot: restored schedule differs from the reference");
+    }
+    checkIndices("snapshot", restored, violations);
+
+    DefaultStaticScheduler static_scheduler;
+    loadWorkload(static_scheduler, workload);
+    static_scheduler.schedule();
+    if (static_scheduler.getSchedule() != reference.getSchedule()) {
+        violations.push_back("static: schedule differs from the reference");
+    }
+
+    // without a cap the policies only change which employee of a type is picked, so the buildings land on the same days
+    for (const auto& [label, policy] : {make_pair("least-assigned", AssignmentPolicy::LEAST_ASSIGNED), make_pair("round-robin", AssignmentPolicy::ROUND_ROBIN),
+                                 make_pair("nearest", AssignmentPolicy::NEAREST)}) {
+        Scheduler fair;
+        fair.setAssignmentPolicy(policy);
+        loadWorkload(fair, workload);
+        fair.schedule();
+        checkSchedule(label, workload, fair.getSchedule(), violations);
+        checkIndices(label, fair, violations);
+        if (daysByBuilding(fair.getSchedule()) != reference_days) {
+            violations.push_back(string(label) + ": buildings scheduled on other days than the reference");
+        }
+    }
+
+    for (const auto& [label, policy] : {make_pair("capped", AssignmentPolicy::LEAST_ASSIGNED), make_pair("capped nearest", AssignmentPolicy::NEAREST)}) {
+        Scheduler capped;
+        capped.setAssignmentPolicy(policy);
+        capped.setWeeklyHourCap(2 * SHIFT_HOURS);
+        loadWorkload(capped, workload);
+        capped.schedule();
+        checkSchedule(label, workload, capped.getSchedule(), violations);
+        for (const auto& employee : workload.employees) {
+            if (capped.getAssignedHours(employee.id) > 2 * SHIFT_HOURS) {
+                violations.push_back(string(label) + ": employee " + to_string(employee.id) + " exceeds the weekly cap");
+            }
+        }
+    }
+
+    return violations;
+}
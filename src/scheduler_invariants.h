@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <random>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include "scheduler.h"
+
+
+// a sequence of scheduler calls: employees and buildings are added, the availability updates applied, then schedule()
+struct Workload {
+    std::vector<Building> buildings;
+    std::vector<Employee> employees;
+    std::vector<std::pair<int, std::vector<bool>>> availabilityUpdates;
+};
+
+// the generator shared by the tests, the property test and the benchmark: employee ids 1..employeeCount, buildings named
+// "Build <n>", each day available with availabilityRate, drawn once per workload when not given
+Workload randomWorkload(std::mt19937& rng, int buildingCount, int employeeCount, int updateCount,
+                        std::optional<double> availabilityRate = std::nullopt);
+Workload workloadFromBytes(const std::uint8_t* data, std::size_t size); //decodes fuzzer input, any byte string is a valid workload
+
+// adds the buildings and the employees, with their locations when the scheduler takes them, then applies the updates
+template <typename SchedulerT>
+void loadWorkload(SchedulerT& scheduler, const Workload& workload) {
+    for (const Building& building : workload.buildings) {
+        if constexpr (requires { scheduler.addBuilding(building.name, building.type, building.location); }) {
+            scheduler.addBuilding(building.name, building.type, building.location);
+        } else {
+            scheduler.addBuilding(building.name, building.type);
+        }
+    }
+    for (const auto& employee : workload.employees) {
+        if constexpr (requires { scheduler.addEmployee(employee.id, employee.type, employee.availability, employee.location); }) {
+            scheduler.addEmployee(employee.id, employee.type, employee.availability, employee.location);
+        } else {
+            scheduler.addEmployee(employee.id, employee.type, employee.availability);
+        }
+    }
+    for (const auto& [employeeId, availability] : workload.availabilityUpdates) {
+        scheduler.updateAvailability(employeeId, availability);
+    }
+}
+
+// runs the workload through Scheduler, StaticScheduler, CompactScheduler, RollingScheduler, chunked and cancelled
+// scheduleAsync runs, snapshot round-trips and the assignment policies and checks the schedule invariants:
+// no employee double-booked on a day, every crew staffs one of the requirement alternatives, only available
+// employees assigned, the lookup indices agree with the schedule and the optimized paths match the reference output.
+// Returns the violations found, empty when the workload passes.
+std::vector<std::string> checkWorkload(const Workload& workload);
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "scheduler_invariants.h"
+
+using namespace std;
+
+
+class SchedulerPropertyTest : public testing::TestWithParam<unsigned> {};
+
+TEST_P(SchedulerPropertyTest, largeRandomWorkload) {
+    mt19937 rng(GetParam());
+    Workload workload = randomWorkload(rng, 2000, 400, 200);
+
+    auto violations = checkWorkload(workload);
+    for (const auto& violation : violations) {
+        ADD_FAILURE() << violation;
+    }
+}
+
+TEST_P(SchedulerPropertyTest, smallRandomWorkload) {
+    // small rosters hit the corner cases: empty pools, a single worker of a type, buildings left over
+    mt19937 rng(GetParam());
+    uniform_int_distribution<int> count_dist(0, 20);
+    Workload workload = randomWorkload(rng, count_dist(rng), count_dist(rng), count_dist(rng));
+
+    auto violations = checkWorkload(workload);
+    for (const auto& violation : violations) {
+        ADD_FAILURE() << violation;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Seeds, SchedulerPropertyTest, testing::Range(0u, 25u));
+
+TEST(SchedulerFuzzInputTest, anyBytesDecode) {
+    mt19937 rng(7);
+    uniform_int_distribution<int> byte_dist(0, 255);
+    for (int run = 0; run < 200; run++) {
+        vector<uint8_t> data(run * 8);
+        for (auto& byte : data) {
+            byte = static_cast<uint8_t>(byte_dist(rng));
+        }
+        auto violations = checkWorkload(workloadFromBytes(data.data(), data.size()));
+        EXPECT_TRUE(violations.empty()) << violations.front();
+    }
+}
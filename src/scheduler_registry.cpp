@@ -0,0 +1,305 @@
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+#include "scheduler_registry.h"
+
+using namespace std;
+
+struct SchedulerRegistry::__Run {
+    string tenant;
+    __Shard* shard;
+    __Tenant* state;
+    stop_token stopToken;
+    size_t chunkSize;
+    std::mutex mutex; //orders the start of the run before its completion check
+    future<ScheduleStatus> inner; //of Scheduler::scheduleAsync
+    bool finished = false;
+    promise<ScheduleStatus> done;
+};
+
+SchedulerRegistry::SchedulerRegistry(std::size_t maxResidentTenants, std::size_t threads, std::size_t shards, TenantLoader_Type loader):
+    __max_resident(max<size_t>(1, maxResidentTenants)),
+    __resident_count(0),
+    __clock(0),
+    __loader(std::move(loader)),
+    __shards(max<size_t>(shards, 1)),
+    __pool(threads)
+    {}
+
+SchedulerRegistry::~SchedulerRegistry() = default;
+
+SchedulerRegistry::__Shard& SchedulerRegistry::__shardOf(const std::string& tenant) {
+    return __shards[hash<string>{}(tenant) % __shards.size()];
+}
+
+const SchedulerRegistry::__Shard& SchedulerRegistry::__shardOf(const std::string& tenant) const {
+    return __shards[hash<string>{}(tenant) % __shards.size()];
+}
+
+SchedulerRegistry::__Tenant& SchedulerRegistry::__pin(__Shard& shard, const std::string& tenant) {
+    lock_guard<std::mutex> lock(shard.mutex);
+    auto& slot = shard.tenants[tenant];
+    if (!slot) {
+        slot = make_unique<__Tenant>();
+    }
+    __Tenant& tenantState = *slot;
+    tenantState.pins++;
+    tenantState.lastUse = ++__clock;
+    if (tenantState.resident) {
+        shard.lru.splice(shard.lru.begin(), shard.lru, tenantState.lruPosition);
+    }
+    return tenantState;
+}
+
+void SchedulerRegistry::__unpin(__Shard& shard, __Tenant& tenantState) {
+    {
+        lock_guard<std::mutex> lock(shard.mutex);
+        tenantState.pins--;
+    }
+    __evictIdle();
+}
+
+void SchedulerRegistry::__acquire(__Shard& shard, __Tenant& tenantState) {
+    unique_lock<std::mutex> lock(shard.mutex);
+    if (!tenantState.busy && tenantState.waiting.empty()) {
+        tenantState.busy = true;
+        return;
+    }
+    // after the calls and runs that came first
+    auto ticket = make_shared<__Waiter>();
+    tenantState.waiting.push_back(ticket);
+    tenantState.released.wait(lock, [&] { return ticket->granted; });
+}
+
+void SchedulerRegistry::__release(__Shard& shard, __Tenant& tenantState) {
+    shared_ptr<__Waiter> next;
+    {
+        lock_guard<std::mutex> lock(shard.mutex);
+        if (tenantState.waiting.empty()) {
+            tenantState.busy = false;
+        } else {
+            next = std::move(tenantState.waiting.front()); //busy passes to the waiter
+            tenantState.waiting.pop_front();
+            next->granted = true;
+        }
+    }
+    if (!next) {
+        return;
+    }
+    if (next->run) {
+        __pool.post([this, run = next->run] { __beginRun(run); });
+    } else {
+        tenantState.released.notify_all();
+    }
+}
+
+void SchedulerRegistry::__evictIdle() {
+    while (__resident_count > __max_resident) {
+        // the least recently used idle tenant over all the shards, each LRU tail is the oldest of its shard
+        __Shard* victim_shard = nullptr;
+        __Tenant* victim = nullptr;
+        uint64_t victim_use = 0;
+        for (__Shard& shard : __shards) {
+            lock_guard<std::mutex> lock(shard.mutex);
+            for (auto it = shard.lru.rbegin(); it != shard.lru.rend(); ++it) {
+                if ((*it)->pins == 0 && !(*it)->busy) {
+                    if (victim == nullptr || (*it)->lastUse < victim_use) {
+                        victim_shard = &shard;
+                        victim = *it;
+                        victim_use = victim->lastUse;
+                    }
+                    break;
+                }
+            }
+        }
+        if (victim == nullptr) {
+            return; //every resident tenant is in use
+        }
+
+        unique_ptr<Scheduler> scheduler;
+        {
+            lock_guard<std::mutex> lock(victim_shard->mutex);
+            if (!victim->resident || victim->pins > 0 || victim->busy) {
+                continue; //used or evicted by another thread meanwhile
+            }
+            victim->busy = true;
+            victim->resident = false;
+            victim_shard->lru.erase(victim->lruPosition);
+            __resident_count--;
+            scheduler = std::move(victim->scheduler);
+        }
+        // serialized outside the shard lock, busy keeps the tenant's calls and runs waiting until the snapshot is in
+        try {
+            victim->snapshot = scheduler->saveSnapshot();
+        } catch (...) {
+            // out of memory for the snapshot, the tenant stays resident and the limit is left for a later unpin
+            {
+                lock_guard<std::mutex> lock(victim_shard->mutex);
+                victim->scheduler = std::move(scheduler);
+                victim->resident = true;
+                victim_shard->lru.push_back(victim);
+                victim->lruPosition = prev(victim_shard->lru.end());
+                __resident_count++;
+            }
+            __release(*victim_shard, *victim);
+            return;
+        }
+        scheduler.reset();
+        __release(*victim_shard, *victim);
+    }
+}
+
+void SchedulerRegistry::__makeResident(const std::string& tenant, __Tenant& tenantState) {
+    if (tenantState.scheduler) {
+        return;
+    }
+    // built outside the shard lock, busy keeps the tenant from being evicted meanwhile
+    auto scheduler = make_unique<Scheduler>();
+    if (tenantState.rules) {
+        scheduler->setBuildingRequirements(tenantState.rules);
+    }
+    if (!tenantState.snapshot.empty()) {
+        scheduler->loadSnapshot(tenantState.snapshot);
+        scheduler->setOperationLog(tenantState.log);
+    } else if (!tenantState.loaded && __loader) {
+        __loader(tenant, *scheduler);
+        __keepState(*scheduler, tenantState);
+    }
+    tenantState.loaded = true;
+    tenantState.snapshot.clear();
+    tenantState.snapshot.shrink_to_fit();
+
+    __Shard& shard = __shardOf(tenant);
+    lock_guard<std::mutex> lock(shard.mutex);
+    tenantState.scheduler = std::move(scheduler);
+    tenantState.resident = true;
+    shard.lru.push_front(&tenantState);
+    tenantState.lruPosition = shard.lru.begin();
+    __resident_count++;
+}
+
+void SchedulerRegistry::__keepState(const Scheduler& scheduler, __Tenant& tenantState) {
+    tenantState.rules = scheduler.getBuildingRequirements();
+    tenantState.log = scheduler.getOperationLog();
+}
+
+void SchedulerRegistry::setTenantRules(const std::string& tenant, Rules_Type rules) {
+    __Shard& shard = __shardOf(tenant);
+    __Tenant& tenantState = __pin(shard, tenant);
+    __acquire(shard, tenantState);
+    tenantState.rules = rules;
+    if (tenantState.scheduler) {
+        tenantState.scheduler->setBuildingRequirements(rules);
+    }
+    __release(shard, tenantState);
+    __unpin(shard, tenantState);
+}
+
+void SchedulerRegistry::withTenant(const std::string& tenant, const std::function<void(Scheduler&)>& fn) {
+    __Shard& shard = __shardOf(tenant);
+    __Tenant& tenantState = __pin(shard, tenant);
+    __acquire(shard, tenantState);
+    try {
+        __makeResident(tenant, tenantState);
+        fn(*tenantState.scheduler);
+        __keepState(*tenantState.scheduler, tenantState);
+    } catch (...) {
+        if (tenantState.scheduler) {
+            __keepState(*tenantState.scheduler, tenantState); //fn may have changed them before it threw
+        }
+        __release(shard, tenantState);
+        __unpin(shard, tenantState);
+        throw;
+    }
+    __release(shard, tenantState);
+    __unpin(shard, tenantState);
+}
+
+std::future<ScheduleStatus> SchedulerRegistry::scheduleTenant(const std::string& tenant, std::stop_token stopToken, std::size_t chunkSize) {
+    auto run = make_shared<__Run>();
+    run->tenant = tenant;
+    run->shard = &__shardOf(tenant);
+    run->state = &__pin(*run->shard, tenant);
+    run->stopToken = std::move(stopToken);
+    run->chunkSize = chunkSize;
+    future<ScheduleStatus> result = run->done.get_future();
+    __pool.post([this, run] { __startRun(run); });
+    return result;
+}
+
+void SchedulerRegistry::__startRun(const std::shared_ptr<__Run>& run) {
+    {
+        lock_guard<std::mutex> lock(run->shard->mutex);
+        if (run->state->busy || !run->state->waiting.empty()) {
+            // the tenant is in use, __release posts the run once it is its turn instead of a worker waiting for it
+            auto ticket = make_shared<__Waiter>();
+            ticket->run = run;
+            run->state->waiting.push_back(std::move(ticket));
+            return;
+        }
+        run->state->busy = true;
+    }
+    __beginRun(run);
+}
+
+void SchedulerRegistry::__beginRun(const std::shared_ptr<__Run>& run) {
+    lock_guard<std::mutex> lock(run->mutex);
+    try {
+        __makeResident(run->tenant, *run->state);
+        auto executor = [this, run](std::function<void()> task) {
+            __pool.post([this, run, task = std::move(task)] {
+                task();
+                __checkRun(run);
+            });
+        };
+        run->inner = run->state->scheduler->scheduleAsync(executor, run->stopToken, {}, run->chunkSize);
+    } catch (...) {
+        run->finished = true;
+        __release(*run->shard, *run->state);
+        __unpin(*run->shard, *run->state);
+        run->done.set_exception(current_exception());
+    }
+}
+
+void SchedulerRegistry::__checkRun(const std::shared_ptr<__Run>& run) {
+    lock_guard<std::mutex> lock(run->mutex);
+    if (run->finished || !run->inner.valid() || run->inner.wait_for(chrono::seconds(0)) != future_status::ready) {
+        return;
+    }
+    run->finished = true;
+    __release(*run->shard, *run->state);
+    __unpin(*run->shard, *run->state);
+    try {
+        run->done.set_value(run->inner.get());
+    } catch (...) {
+        run->done.set_exception(current_exception());
+    }
+}
+
+bool SchedulerRegistry::isResident(const std::string& tenant) const {
+    const __Shard& shard = __shardOf(tenant);
+    lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.tenants.find(tenant);
+    return found != shard.tenants.end() && found->second->resident;
+}
+
+std::size_t SchedulerRegistry::residentCount() const {
+    return __resident_count;
+}
+
+std::size_t SchedulerRegistry::tenantCount() const {
+    size_t count = 0;
+    for (const __Shard& shard : __shards) {
+        lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.tenants.size();
+    }
+    return count;
+}
+
+std::size_t SchedulerRegistry::waitingCount(const std::string& tenant) const {
+    const __Shard& shard = __shardOf(tenant);
+    lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.tenants.find(tenant);
+    return found == shard.tenants.end() ? 0 : found->second->waiting.size();
+}
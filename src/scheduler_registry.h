@@ -0,0 +1,96 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <stop_token>
+#include <cstddef>
+#include <cstdint>
+#include "scheduler.h"
+#include "thread_pool.h"
+
+
+// One Scheduler per tenant, created on first use. The tenants are spread over shards by name, each shard with
+// its own lock and LRU list; past maxResidentTenants, counted over all the shards, the least recently used idle
+// tenants are evicted to their compact snapshot and loaded back from it when used again. scheduleTenant runs on a
+// fixed-size thread pool in chunks of buildings, so a large tenant's run takes turns with the other tenants instead
+// of holding a thread; a run on a tenant in use waits in the tenant's queue, not on a worker. Calls and runs on one
+// tenant are served in the order they arrive.
+// The rules and the operation log of a tenant outlive its eviction, whether they were set through setTenantRules or on
+// the scheduler inside withTenant: they are kept with the snapshot and set again on the scheduler loaded back. The
+// log then records a snapshot of the reloaded tenant, see Scheduler::setOperationLog, and must stay alive until it is
+// detached with setOperationLog(nullptr) in withTenant.
+class SchedulerRegistry {
+    public:
+        using Rules_Type = std::shared_ptr<const Scheduler::BuildingRequrement_Type>;
+        using TenantLoader_Type = std::function<void(const std::string& tenant, Scheduler& scheduler)>; //fills a new tenant
+
+        SchedulerRegistry(std::size_t maxResidentTenants, std::size_t threads, std::size_t shards = 16, TenantLoader_Type loader = {});
+        ~SchedulerRegistry(); //waits for the runs in flight
+        SchedulerRegistry(const SchedulerRegistry&) = delete;
+        SchedulerRegistry& operator=(const SchedulerRegistry&) = delete;
+
+        void setTenantRules(const std::string& tenant, Rules_Type rules); //nullptr goes back to Scheduler::buildingRequirements
+        // calls fn with the tenant's scheduler, loading it first if needed; calls on one tenant run one at a time
+        void withTenant(const std::string& tenant, const std::function<void(Scheduler&)>& fn);
+        std::future<ScheduleStatus> scheduleTenant(const std::string& tenant, std::stop_token stopToken = {},
+                                                   std::size_t chunkSize = DEFAULT_SCHEDULE_CHUNK);
+        bool isResident(const std::string& tenant) const;
+        std::size_t residentCount() const;
+        std::size_t tenantCount() const;
+        std::size_t waitingCount(const std::string& tenant) const; //calls and runs waiting for the tenant to be free
+
+    private:
+        struct __Run; //state of a scheduleTenant run
+        struct __Waiter {
+            std::shared_ptr<__Run> run; //null for a withTenant or setTenantRules call
+            bool granted = false; //busy was handed to the waiter
+        };
+        struct __Tenant {
+            // busy while a call, a run or an eviction uses the scheduler, can be released by any thread
+            bool busy = false;
+            std::condition_variable released; //calls waiting for their turn
+            std::deque<std::shared_ptr<__Waiter>> waiting; //calls and runs waiting for busy, handed the tenant in arrival order
+            std::unique_ptr<Scheduler> scheduler; //null while evicted, busy held to use
+            std::string snapshot; //compact form while evicted, empty for a tenant never loaded, busy held to use
+            bool loaded = false; //the loader ran, busy held to read or write
+            Rules_Type rules; //busy held to read or write
+            OperationLog* log = nullptr; //of the scheduler, kept across evictions, busy held to read or write
+            int pins = 0; //calls and runs holding the tenant, pinned tenants are not evicted
+            bool resident = false;
+            std::uint64_t lastUse = 0; //registry tick of the last pin, orders the LRU tails of the shards
+            std::list<__Tenant*>::iterator lruPosition; //valid while resident
+        };
+        struct __Shard {
+            mutable std::mutex mutex; //guards the map, the LRU list, the busy flags, pins and residency of its tenants
+            std::unordered_map<std::string, std::unique_ptr<__Tenant>> tenants;
+            std::list<__Tenant*> lru; //resident tenants, most recently used first
+        };
+
+        std::size_t __max_resident;
+        std::atomic<std::size_t> __resident_count; //over all the shards
+        std::atomic<std::uint64_t> __clock; //ticks on every pin
+        TenantLoader_Type __loader;
+        std::vector<__Shard> __shards;
+        ThreadPool __pool; //last member, joined first on destruction
+
+        __Shard& __shardOf(const std::string& tenant);
+        const __Shard& __shardOf(const std::string& tenant) const;
+        __Tenant& __pin(__Shard& shard, const std::string& tenant);
+        void __unpin(__Shard& shard, __Tenant& tenantState); //then evicts while over the resident limit
+        void __acquire(__Shard& shard, __Tenant& tenantState); //waits for the turn of the call and sets busy
+        void __release(__Shard& shard, __Tenant& tenantState); //hands the tenant to the next waiting call or run, or clears busy
+        void __evictIdle();
+        void __makeResident(const std::string& tenant, __Tenant& tenantState); //busy held
+        void __keepState(const Scheduler& scheduler, __Tenant& tenantState); //rules and log to restore after an eviction, busy held
+        void __startRun(const std::shared_ptr<__Run>& run); //queues the run if the tenant is busy
+        void __beginRun(const std::shared_ptr<__Run>& run); //busy held
+        void __checkRun(const std::shared_ptr<__Run>& run); //finishes the run once its future is ready
+};
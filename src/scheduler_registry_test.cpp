@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <filesystem>
+#include "operation_log.h"
+#include "scheduler_registry.h"
+
+using namespace std;
+
+
+namespace {
+void loadTenant(const string& tenant, Scheduler& scheduler) {
+    int size = static_cast<int>(tenant.size());
+    for (int b = 0; b < size; b++) {
+        scheduler.addBuilding(tenant + " building " + to_string(b), static_cast<BuildingType>(b % 2));
+    }
+    for (int id = 1; id <= 2 * size; id++) {
+        scheduler.addEmployee(id, static_cast<EmployeeType>(id % EMPLOYEE_TYPES), {true, id % 2 == 0, true, true, id % 3 == 0});
+    }
+}
+
+Schedule_Type scheduleOf(SchedulerRegistry& registry, const string& tenant) {
+    Schedule_Type schedule;
+    registry.withTenant(tenant, [&](Scheduler& scheduler) { schedule = scheduler.getSchedule(); });
+    return schedule;
+}
+}
+
+
+TEST(SchedulerRegistryTest, tenantsAreLoadedLazily) {
+    atomic<int> loads = 0;
+    SchedulerRegistry registry(8, 2, 4, [&](const string& tenant, Scheduler& scheduler) {
+        loads++;
+        loadTenant(tenant, scheduler);
+    });
+    EXPECT_EQ(0, registry.tenantCount());
+
+    registry.withTenant("acme", [](Scheduler& scheduler) { scheduler.schedule(); });
+    registry.withTenant("acme", [](Scheduler&) {});
+    EXPECT_EQ(1, loads);
+    EXPECT_EQ(1, registry.tenantCount());
+    EXPECT_TRUE(registry.isResident("acme"));
+    EXPECT_FALSE(registry.isResident("globex"));
+
+    Scheduler expected;
+    loadTenant("acme", expected);
+    expected.schedule();
+    EXPECT_EQ(expected.getSchedule(), scheduleOf(registry, "acme"));
+}
+
+TEST(SchedulerRegistryTest, idleTenantsAreEvictedAndRestored) {
+    atomic<int> loads = 0;
+    SchedulerRegistry registry(2, 1, 1, [&](const string& tenant, Scheduler& scheduler) {
+        loads++;
+        loadTenant(tenant, scheduler);
+    });
+    registry.withTenant("t1", [](Scheduler& scheduler) { scheduler.schedule(); });
+    Schedule_Type t1_schedule = scheduleOf(registry, "t1");
+    registry.withTenant("t2", [](Scheduler&) {});
+    registry.withTenant("t1", [](Scheduler&) {}); //t2 becomes the least recently used
+    registry.withTenant("t3", [](Scheduler&) {});
+
+    EXPECT_EQ(2, registry.residentCount());
+    EXPECT_EQ(3, registry.tenantCount());
+    EXPECT_TRUE(registry.isResident("t1"));
+    EXPECT_FALSE(registry.isResident("t2"));
+    EXPECT_TRUE(registry.isResident("t3"));
+
+    registry.withTenant("t4", [](Scheduler&) {});
+    EXPECT_FALSE(registry.isResident("t1"));
+
+    // back from the snapshot, not from the loader, with its schedule and its state
+    EXPECT_EQ(t1_schedule, scheduleOf(registry, "t1"));
+    EXPECT_EQ(4, loads);
+    registry.withTenant("t1", [](Scheduler& scheduler) {
+        scheduler.addBuilding("Extra", BuildingType::SINGLE_STORY);
+        scheduler.schedule();
+    });
+    Scheduler expected;
+    loadTenant("t1", expected);
+    expected.schedule();
+    expected.addBuilding("Extra", BuildingType::SINGLE_STORY);
+    expected.schedule();
+    EXPECT_EQ(expected.getSchedule(), scheduleOf(registry, "t1"));
+}
+
+TEST(SchedulerRegistryTest, residentLimitSpansTheShards) {
+    // default shard count, more shards than resident tenants
+    SchedulerRegistry registry(2, 1);
+    for (int t = 0; t < 40; t++) {
+        registry.withTenant("tenant " + to_string(t), [](Scheduler&) {});
+    }
+    EXPECT_EQ(2, registry.residentCount());
+    EXPECT_EQ(40, registry.tenantCount());
+    EXPECT_TRUE(registry.isResident("tenant 38"));
+    EXPECT_TRUE(registry.isResident("tenant 39"));
+}
+
+TEST(SchedulerRegistryTest, rulesArePerTenant) {
+    SchedulerRegistry registry(1, 1, 1);
+    auto laborer_houses = make_shared<Scheduler::BuildingRequrement_Type>(Scheduler::BuildingRequrement_Type{
+        {BuildingType::SINGLE_STORY, {{{EmployeeType::LABORER, 1}}}}
+    });
+    registry.setTenantRules("custom", laborer_houses);
+    for (const string tenant : {"custom", "default"}) {
+        registry.withTenant(tenant, [](Scheduler& scheduler) {
+            scheduler.addBuilding("House", BuildingType::SINGLE_STORY);
+            scheduler.addEmployee(1, EmployeeType::LABORER, {true, true, true, true, true});
+            scheduler.schedule();
+        });
+    }
+    // the rules survive the eviction of the tenant
+    EXPECT_FALSE(registry.isResident("custom"));
+    registry.withTenant("custom", [](Scheduler& scheduler) {
+        EXPECT_TRUE(scheduler.getBuildingAssignment("House").has_value());
+        scheduler.addBuilding("Second house", BuildingType::SINGLE_STORY);
+        scheduler.addEmployee(2, EmployeeType::LABORER, {true, true, true, true, true});
+        scheduler.schedule();
+        EXPECT_TRUE(scheduler.getBuildingAssignment("Second house").has_value());
+    });
+    registry.withTenant("default", [](Scheduler& scheduler) {
+        EXPECT_FALSE(scheduler.getBuildingAssignment("House").has_value());
+    });
+}
+
+TEST(SchedulerRegistryTest, tenantsScheduleConcurrently) {
+    SchedulerRegistry registry(16, 4, 4, loadTenant);
+    vector<string> tenants;
+    vector<future<ScheduleStatus>> runs;
+    for (int t = 0; t < 40; t++) {
+        tenants.push_back("tenant " + string(t % 7 + 1, 'x') + to_string(t));
+        runs.push_back(registry.scheduleTenant(tenants.back(), {}, 3));
+    }
+    for (auto& run : runs) {
+        EXPECT_EQ(ScheduleStatus::COMPLETED, run.get());
+    }
+    for (const auto& tenant : tenants) {
+        Scheduler expected;
+        loadTenant(tenant, expected);
+        expected.schedule();
+        EXPECT_EQ(expected.getSchedule(), scheduleOf(registry, tenant)) << tenant;
+    }
+    EXPECT_LE(registry.residentCount(), 16);
+}
+
+TEST(SchedulerRegistryTest, largeTenantDoesntStarveSmallOnes) {
+    SchedulerRegistry registry(4, 1, 1, [](const string& tenant, Scheduler& scheduler) {
+        int buildings = tenant == "large" ? 5000 : 3;
+        for (int b = 0; b < buildings; b++) {
+            scheduler.addBuilding("Build " + to_string(b), BuildingType::TWO_STORY);
+        }
+        scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    });
+    auto large = registry.scheduleTenant("large", {}, 1);
+    auto small = registry.scheduleTenant("small", {}, 1);
+
+    // one worker: the small run finishes while the large one is still taking turns
+    EXPECT_EQ(ScheduleStatus::COMPLETED, small.get());
+    EXPECT_EQ(future_status::timeout, large.wait_for(chrono::seconds(0)));
+    EXPECT_EQ(ScheduleStatus::COMPLETED, large.get());
+}
+
+TEST(SchedulerRegistryTest, runsCanBeStopped) {
+    SchedulerRegistry registry(4, 2, 1, loadTenant);
+    stop_source deadline;
+    deadline.request_stop();
+    EXPECT_EQ(ScheduleStatus::CANCELLED, registry.scheduleTenant("stopped tenant", deadline.get_token()).get());
+    // the tenant is free again
+    registry.withTenant("stopped tenant", [](Scheduler& scheduler) {
+        for (const auto& day : scheduler.getSchedule()) {
+            EXPECT_TRUE(day.empty());
+        }
+    });
+    EXPECT_EQ(ScheduleStatus::COMPLETED, registry.scheduleTenant("stopped tenant").get());
+}
+
+TEST(SchedulerRegistryTest, runWaitsForTheTenantWithoutAWorker) {
+    SchedulerRegistry registry(4, 1, 1, loadTenant);
+    future<ScheduleStatus> queued;
+    registry.withTenant("held", [&](Scheduler&) {
+        queued = registry.scheduleTenant("held", {}, 2);
+        // the only worker is free to run another tenant while this one is held
+        EXPECT_EQ(ScheduleStatus::COMPLETED, registry.scheduleTenant("other", {}, 2).get());
+        EXPECT_EQ(future_status::timeout, queued.wait_for(chrono::seconds(0)));
+    });
+    EXPECT_EQ(ScheduleStatus::COMPLETED, queued.get());
+
+    Scheduler expected;
+    loadTenant("held", expected);
+    expected.schedule();
+    EXPECT_EQ(expected.getSchedule(), scheduleOf(registry, "held"));
+}
+
+TEST(SchedulerRegistryTest, callsAndRunsAreServedInArrivalOrder) {
+    SchedulerRegistry registry(4, 1, 1, loadTenant);
+    future<ScheduleStatus> first_run, second_run;
+    thread caller;
+    bool call_saw_first_run = false;
+    bool call_saw_second_run = true;
+    registry.withTenant("held", [&](Scheduler&) {
+        first_run = registry.scheduleTenant("held", {}, 2);
+        registry.scheduleTenant("other").get(); //the only worker queued the run before getting here
+        ASSERT_EQ(1, registry.waitingCount("held"));
+
+        caller = thread([&] {
+            registry.withTenant("held", [&](Scheduler& scheduler) {
+                call_saw_first_run = scheduler.getBuildingAssignment("held building 0").has_value();
+                call_saw_second_run = scheduler.getBuildingAssignment("Late building").has_value();
+                scheduler.addBuilding("Late building", BuildingType::SINGLE_STORY);
+            });
+        });
+        while (registry.waitingCount("held") < 2) {
+            this_thread::yield();
+        }
+        second_run = registry.scheduleTenant("held", {}, 2);
+        registry.scheduleTenant("other").get();
+        EXPECT_EQ(3, registry.waitingCount("held"));
+    });
+    caller.join();
+    EXPECT_EQ(ScheduleStatus::COMPLETED, first_run.get());
+    EXPECT_EQ(ScheduleStatus::COMPLETED, second_run.get());
+
+    // the call came between the runs: after the first one, before the second one placed the building it added
+    EXPECT_TRUE(call_saw_first_run);
+    EXPECT_FALSE(call_saw_second_run);
+    registry.withTenant("held", [](Scheduler& scheduler) {
+        EXPECT_TRUE(scheduler.getBuildingAssignment("Late building").has_value());
+    });
+}
+
+TEST(SchedulerRegistryTest, rulesAndLogSetInACallSurviveEviction) {
+    const string path = (filesystem::path(testing::TempDir()) / "registry_tenant.log").string();
+    filesystem::remove(path);
+    auto laborer_houses = make_shared<Scheduler::BuildingRequrement_Type>(Scheduler::BuildingRequrement_Type{
+        {BuildingType::SINGLE_STORY, {{{EmployeeType::LABORER, 1}}}}
+    });
+    Schedule_Type schedule;
+    {
+        OperationLog log(path);
+        SchedulerRegistry registry(1, 1, 1);
+        registry.withTenant("custom", [&](Scheduler& scheduler) {
+            scheduler.setOperationLog(&log);
+            scheduler.setBuildingRequirements(laborer_houses);
+            scheduler.addEmployee(1, EmployeeType::LABORER, {true, true, true, true, true});
+        });
+        registry.withTenant("other", [](Scheduler&) {});
+        ASSERT_FALSE(registry.isResident("custom"));
+
+        registry.withTenant("custom", [&](Scheduler& scheduler) {
+            EXPECT_EQ(laborer_houses, scheduler.getBuildingRequirements());
+            EXPECT_EQ(&log, scheduler.getOperationLog());
+            scheduler.addBuilding("House", BuildingType::SINGLE_STORY);
+            scheduler.schedule();
+            EXPECT_TRUE(scheduler.getBuildingAssignment("House").has_value());
+            schedule = scheduler.getSchedule();
+            scheduler.setOperationLog(nullptr);
+        });
+    }
+
+    // the calls after the reload are in the log too
+    Scheduler replayed;
+    replayOperationLog(path, replayed);
+    EXPECT_EQ(schedule, replayed.getSchedule());
+    filesystem::remove(path);
+}
@@ -0,0 +1,195 @@
+#include <unordered_set>
+
+#include "scheduler.h"
+#include "operation_log.h"
+#include "byte_codec.h"
+
+using namespace std;
+
+// Snapshot layout, integers as varints (zigzag when signed):
+//   version, policy, weekly hour cap, assignment sequence, travel distance, diagnostics
+//   employees: id, type, availability bits, location, assigned hours, last assignment
+//   day pools by type, as employee ids in pool order (the order greedy picks from)
+//   buildings left: name, type, location
+//   schedule by day: building name, crew ids
+// The lookup indices are rebuilt from the schedule, so getEmployeeAssignments lists the days in day order.
+
+namespace {
+constexpr uint8_t SNAPSHOT_FORMAT_VERSION = 1;
+static_assert(WORK_DAYS <= 8, "availability is stored as one byte");
+
+void putLocation(string& bytes, const Location& location) {
+    putDouble(bytes, location.x);
+    putDouble(bytes, location.y);
+}
+
+Location getLocation(ByteReader& reader) {
+    Location location;
+    location.x = reader.getDouble();
+    location.y = reader.getDouble();
+    return location;
+}
+
+template <typename Enum>
+Enum getEnum(ByteReader& reader, int count) {
+    uint8_t value = reader.getByte();
+    if (value >= count) {
+        reader.fail("has an invalid type");
+    }
+    return static_cast<Enum>(value);
+}
+}
+
+std::string Scheduler::saveSnapshot() const {
+    string bytes;
+    bytes.push_back(static_cast<char>(SNAPSHOT_FORMAT_VERSION));
+    bytes.push_back(static_cast<char>(__assignment_policy));
+    putSigned(bytes, __weekly_hour_cap);
+    putSigned(bytes, __assignment_seq);
+    putDouble(bytes, __travel_distance);
+    bytes.push_back(static_cast<char>(__diagnostics));
+
+    putVarint(bytes, __employees_by_id.size());
+    for (const auto& [employeeId, employee] : __employees_by_id) {
+        putSigned(bytes, employeeId);
+        bytes.push_back(static_cast<char>(employee.type));
+        uint8_t availability = 0;
+        for (int day = 0; day < WORK_DAYS; day++) {
+            availability |= static_cast<uint8_t>(employee.availability[day]) << day;
+        }
+        bytes.push_back(static_cast<char>(availability));
+        putLocation(bytes, employee.location);
+        putSigned(bytes, employee.assignedHours);
+        putSigned(bytes, employee.lastAssignment);
+    }
+
+    putVarint(bytes, __employees_by_type_and_day.size());
+    for (const auto& [empType, pools] : __employees_by_type_and_day) {
+        bytes.push_back(static_cast<char>(empType));
+        for (const auto& pool : pools) {
+            putVarint(bytes, pool.size());
+            for (const Employee *emp : pool) {
+                putSigned(bytes, emp->id);
+            }
+        }
+    }
+
+    putVarint(bytes, __buildings.size());
+    for (const Building& building : __buildings) {
+        putText(bytes, building.name);
+        bytes.push_back(static_cast<char>(building.type));
+        putLocation(bytes, building.location);
+    }
+
+    for (const auto& entries : __daily_schedule) {
+        putVarint(bytes, entries.size());
+        for (const auto& [buildName, crew] : entries) {
+            putText(bytes, buildName);
+            putVarint(bytes, crew.size());
+            for (int empId : crew) {
+                putSigned(bytes, empId);
+            }
+        }
+    }
+    return bytes;
+}
+
+void Scheduler::loadSnapshot(std::string_view bytes) {
+    ByteReader reader(bytes, "scheduler snapshot");
+    if (reader.getByte() != SNAPSHOT_FORMAT_VERSION) {
+        reader.fail("has an unknown format");
+    }
+    // parsed into a fresh scheduler, so a malformed snapshot leaves this one untouched
+    Scheduler loaded;
+    loaded.__building_requirements = __building_requirements;
+    loaded.__operation_log = __operation_log;
+    loaded.__assignment_policy = getEnum<AssignmentPolicy>(reader, static_cast<int>(AssignmentPolicy::NEAREST) + 1);
+    loaded.__weekly_hour_cap = reader.getInt();
+    loaded.__assignment_seq = reader.getSigned();
+    loaded.__travel_distance = reader.getDouble();
+    loaded.__diagnostics = reader.getByte() != 0;
+
+    size_t employee_count = reader.getCount();
+    loaded.__employees_by_id.reserve(employee_count);
+    for (size_t e = 0; e < employee_count; e++) {
+        int employeeId = reader.getInt();
+        if (loaded.__employees_by_id.contains(employeeId)) {
+            reader.fail("has a duplicate employee");
+        }
+        EmployeeType empType = getEnum<EmployeeType>(reader, EMPLOYEE_TYPES);
+        uint8_t availability = reader.getByte();
+        vector<bool> empAvailability(WORK_DAYS);
+        for (int day = 0; day < WORK_DAYS; day++) {
+            empAvailability[day] = (availability >> day) & 1;
+        }
+        Employee& employee = loaded.__employees_by_id[employeeId] = Employee(employeeId, empType, empAvailability);
+        employee.location = getLocation(reader);
+        employee.assignedHours = reader.getInt();
+        employee.lastAssignment = reader.getSigned();
+    }
+
+    // a pool holds each employee of its type at most once, and only on the days they are available
+    size_t type_count = reader.getCount();
+    for (size_t t = 0; t < type_count; t++) {
+        EmployeeType empType = getEnum<EmployeeType>(reader, EMPLOYEE_TYPES);
+        if (loaded.__employees_by_type_and_day.contains(empType)) {
+            reader.fail("has a duplicate employee type");
+        }
+        auto& pools = loaded.__employees_by_type_and_day[empType];
+        for (int day = 0; day < WORK_DAYS; day++) {
+            auto& pool = pools[day];
+            pool.resize(reader.getCount());
+            unordered_set<int> pooled;
+            for (Employee*& emp : pool) {
+                auto found = loaded.__employees_by_id.find(reader.getInt());
+                if (found == loaded.__employees_by_id.end()) {
+                    reader.fail("has an unknown employee in a day pool");
+                }
+                if (found->second.type != empType || !found->second.availability[day]) {
+                    reader.fail("has an employee in the pool of another type or day");
+                }
+                if (!pooled.insert(found->first).second) {
+                    reader.fail("has an employee twice in a day pool");
+                }
+                emp = &found->second;
+            }
+        }
+    }
+
+    size_t building_count = reader.getCount();
+    loaded.__buildings.reserve(building_count);
+    for (size_t b = 0; b < building_count; b++) {
+        string buildName(reader.getText());
+        if (loaded.__building_id_by_name.contains(buildName)) {
+            reader.fail("has a duplicate building");
+        }
+        loaded.__internBuildingName(buildName);
+        BuildingType buildType = getEnum<BuildingType>(reader, BUILDING_TYPES);
+        loaded.__buildings.push_back(Building(buildName, buildType, getLocation(reader)));
+    }
+
+    for (int day = 0; day < WORK_DAYS; day++) {
+        size_t entry_count = reader.getCount();
+        for (size_t s = 0; s < entry_count; s++) {
+            string buildName(reader.getText());
+            if (loaded.__building_id_by_name.contains(buildName)) {
+                reader.fail("has a duplicate building");
+            }
+            vector<int> crew(reader.getCount());
+            for (int& empId : crew) {
+                empId = reader.getInt();
+                if (!loaded.__employees_by_id.contains(empId)) {
+                    reader.fail("has an unknown employee in a crew");
+                }
+            }
+            loaded.__assignEmployees(Building(buildName, BuildingType::SINGLE_STORY), day, crew); //only the name is used
+        }
+    }
+    if (!reader.atEnd()) {
+        reader.fail("has trailing bytes");
+    }
+    *this = std::move(loaded);
+    if (__operation_log) {
+        __operation_log->recordLoadSnapshot(bytes); //logged once loaded, a malformed snapshot changes nothing and is not replayed
+    }
+}
@@ -1,5 +1,15 @@
 #include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <cstdint>
 #include "scheduler.h"
+#include "scheduler_invariants.h"
+#include "byte_codec.h"
 
 using namespace std;
 
@@ -623,3 +633,736 @@ TEST_F(SchedulerTest, randomSchedulerStrike) {
 
 
 
+
+
+TEST_F(SchedulerTest, greedyPolicyConcentratesShifts) {
+    buildings = {
+        {"Build 0", BuildingType::SINGLE_STORY},
+        {"Build 1", BuildingType::SINGLE_STORY},
+        {"Build 2", BuildingType::SINGLE_STORY},
+        {"Build 3", BuildingType::SINGLE_STORY}
+    };
+
+    employees = {
+        {1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {3, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {4, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}}
+    };
+
+    for (const Building& building: buildings) {
+        scheduler.addBuilding(building.name, building.type);
+    }
+
+    for (const auto& employee : employees) {
+        scheduler.addEmployee(employee.id, employee.type, employee.availability);
+    }
+
+    scheduler.addBuilding("Build 4", BuildingType::SINGLE_STORY);
+    scheduler.schedule();
+    scheduler.printSchedule();
+
+    // all four buildings fit on Monday, the fifth on Tuesday goes to the last added employee again
+    auto schedule = scheduler.getSchedule();
+    EXPECT_EQ(4, schedule[0].size());
+    EXPECT_EQ(1, schedule[1].size());
+    EXPECT_EQ(std::vector<int>({4}), schedule[1][0].second);
+    EXPECT_EQ(16, scheduler.getAssignedHours(4));
+    EXPECT_EQ(8, scheduler.getAssignedHours(1));
+}
+
+TEST_F(SchedulerTest, leastAssignedPolicySpreadsShifts) {
+    employees = {
+        {1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {3, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}}
+    };
+
+    for (const auto& employee : employees) {
+        scheduler.addEmployee(employee.id, employee.type, employee.availability);
+    }
+    // employee 1 is away on Monday, the others get a head start
+    scheduler.updateAvailability(1, {false, true, true, true, true});
+    for (int b = 0; b < 2; b++) {
+        scheduler.addBuilding("Build " + std::to_string(b), BuildingType::SINGLE_STORY);
+    }
+
+    scheduler.setAssignmentPolicy(AssignmentPolicy::LEAST_ASSIGNED);
+    scheduler.schedule();
+    for (int b = 2; b < 6; b++) {
+        scheduler.addBuilding("Build " + std::to_string(b), BuildingType::SINGLE_STORY);
+        scheduler.updateAvailability(1, {false, true, true, true, true});
+        scheduler.updateAvailability(2, {false, true, true, true, true});
+        scheduler.updateAvailability(3, {false, true, true, true, true});
+        scheduler.schedule();
+    }
+    scheduler.printSchedule();
+
+    auto schedule = scheduler.getSchedule();
+    EXPECT_EQ(2, schedule[0].size());
+    EXPECT_EQ(4, schedule[1].size());
+    // employee 1 catches up first, then the shifts are spread evenly
+    EXPECT_EQ(std::vector<int>({1}), schedule[1][0].second);
+    EXPECT_EQ(16, scheduler.getAssignedHours(1));
+    EXPECT_EQ(16, scheduler.getAssignedHours(2));
+    EXPECT_EQ(16, scheduler.getAssignedHours(3));
+}
+
+TEST_F(SchedulerTest, roundRobinPolicyRotatesEmployees) {
+    employees = {
+        {1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {3, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}}
+    };
+
+    for (const auto& employee : employees) {
+        scheduler.addEmployee(employee.id, employee.type, employee.availability);
+    }
+
+    scheduler.setAssignmentPolicy(AssignmentPolicy::ROUND_ROBIN);
+    std::vector<int> picked;
+    for (int week = 0; week < 6; week++) {
+        // one building per run, the least recently assigned employee takes it
+        scheduler.startWeek();
+        scheduler.addBuilding("Build " + std::to_string(week), BuildingType::SINGLE_STORY);
+        scheduler.schedule();
+        picked.push_back(scheduler.getSchedule()[0].back().second.front());
+        scheduler.updateAvailability(picked.back(), {true, true, true, true, true});
+    }
+
+    EXPECT_EQ(std::vector<int>({3, 2, 1, 3, 2, 1}), picked);
+}
+
+TEST_F(SchedulerTest, weeklyHourCapLimitsShifts) {
+    employees = {
+        {1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}}
+    };
+
+    for (int b = 0; b < 10; b++) {
+        scheduler.addBuilding("Build " + std::to_string(b), BuildingType::SINGLE_STORY);
+    }
+
+    for (const auto& employee : employees) {
+        scheduler.addEmployee(employee.id, employee.type, employee.availability);
+    }
+
+    scheduler.setWeeklyHourCap(3 * SHIFT_HOURS);
+    scheduler.schedule();
+    scheduler.printSchedule();
+
+    auto schedule = scheduler.getSchedule();
+    // three shifts each, Thursday and Friday stay empty
+    EXPECT_EQ(2, schedule[0].size());
+    EXPECT_EQ(2, schedule[1].size());
+    EXPECT_EQ(2, schedule[2].size());
+    EXPECT_EQ(0, schedule[3].size());
+    EXPECT_EQ(0, schedule[4].size());
+    EXPECT_EQ(24, scheduler.getAssignedHours(1));
+    EXPECT_EQ(24, scheduler.getAssignedHours(2));
+}
+
+TEST_F(SchedulerTest, startWeekResetsTheCap) {
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    for (int b = 0; b < 3; b++) {
+        scheduler.addBuilding("Build " + std::to_string(b), BuildingType::SINGLE_STORY);
+    }
+
+    scheduler.setWeeklyHourCap(SHIFT_HOURS);
+    scheduler.schedule();
+    EXPECT_EQ(SHIFT_HOURS, scheduler.getAssignedHours(1));
+
+    // still capped until the week is over
+    scheduler.updateAvailability(1, {true, true, true, true, true});
+    scheduler.schedule();
+    EXPECT_EQ(1, scheduler.getSchedule()[0].size());
+
+    scheduler.startWeek();
+    EXPECT_EQ(0, scheduler.getAssignedHours(1));
+    scheduler.updateAvailability(1, {true, true, true, true, true});
+    scheduler.schedule();
+
+    auto schedule = scheduler.getSchedule();
+    ASSERT_EQ(2, schedule[0].size());
+    EXPECT_EQ("Build 1", schedule[0][1].first);
+    EXPECT_EQ(SHIFT_HOURS, scheduler.getAssignedHours(1));
+}
+
+TEST_F(SchedulerTest, weeklyHourCapWithLeastAssigned) {
+    employees = {
+        {1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {3, EmployeeType::LABORER, {true, true, true, true, true}}
+    };
+
+    for (int b = 0; b < 10; b++) {
+        scheduler.addBuilding("Build " + std::to_string(b), BuildingType::TWO_STORY);
+    }
+
+    for (const auto& employee : employees) {
+        scheduler.addEmployee(employee.id, employee.type, employee.availability);
+    }
+
+    scheduler.setAssignmentPolicy(AssignmentPolicy::LEAST_ASSIGNED);
+    scheduler.setWeeklyHourCap(2 * SHIFT_HOURS);
+    scheduler.schedule();
+    scheduler.printSchedule();
+
+    auto schedule = scheduler.getSchedule();
+    // the laborer is capped after two days, no crew can be formed afterwards
+    EXPECT_EQ(1, schedule[0].size());
+    EXPECT_EQ(1, schedule[1].size());
+    EXPECT_EQ(0, schedule[2].size());
+    EXPECT_EQ(16, scheduler.getAssignedHours(3));
+    EXPECT_EQ(8, scheduler.getAssignedHours(1));
+    EXPECT_EQ(8, scheduler.getAssignedHours(2));
+}
+
+TEST_F(SchedulerTest, employeeAndBuildingLookups) {
+    buildings = {
+        {"Build 0", BuildingType::TWO_STORY},
+        {"Build 1", BuildingType::COMMERCIAL},
+        {"Build 2", BuildingType::TWO_STORY},
+        {"Build 3", BuildingType::SINGLE_STORY},
+        {"Build 4", BuildingType::SINGLE_STORY}
+    };
+
+    employees = {
+        {1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, false, true}},
+        {3, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, false, true, false}},
+        {4, EmployeeType::LABORER, {true, true, true, false, false}},
+        {5, EmployeeType::LABORER, {true, true, false, true, true}},
+        {6, EmployeeType::CERTIFIED_INSTALLER, {false, true, true, false, true}},
+        {7, EmployeeType::LABORER, {true, true, true, false, true}},
+        {8, EmployeeType::LABORER, {true, true, true, false, true}},
+        {9, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, false, true, false, true}},
+        {10, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, true, true, true}}
+    };
+
+    for (const Building& building: buildings) {
+        scheduler.addBuilding(building.name, building.type);
+    }
+
+    for (const auto& employee : employees) {
+        scheduler.addEmployee(employee.id, employee.type, employee.availability);
+    }
+
+    scheduler.schedule();
+
+    // same schedule as randomSchedule, employee 6 builds Build 1 on Tuesday and Build 4 on Wednesday
+    auto assignments = scheduler.getEmployeeAssignments(6);
+    ASSERT_EQ(2, assignments.size());
+    EXPECT_EQ(1, assignments[0].day);
+    EXPECT_EQ("Build 1", assignments[0].building);
+    EXPECT_EQ(2, assignments[1].day);
+    EXPECT_EQ("Build 4", assignments[1].building);
+
+    EXPECT_TRUE(scheduler.getEmployeeAssignments(9).empty());
+    EXPECT_TRUE(scheduler.getEmployeeAssignments(42).empty());
+
+    auto build1 = scheduler.getBuildingAssignment("Build 1");
+    ASSERT_TRUE(build1.has_value());
+    EXPECT_EQ(1, build1->day);
+    EXPECT_EQ(std::vector<int>({6, 2, 10, 3, 8, 7, 5, 4}), std::vector<int>(build1->crew.begin(), build1->crew.end()));
+    // the crew span views the schedule itself, no copy
+    EXPECT_EQ(scheduler.getSchedule()[1][0].second.data(), build1->crew.data());
+
+    EXPECT_FALSE(scheduler.getBuildingAssignment("Build 42").has_value());
+}
+
+TEST_F(SchedulerTest, duplicateBuildingNamesAreRejected) {
+    scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+    EXPECT_THROW(scheduler.addBuilding("Build 0", BuildingType::COMMERCIAL), std::invalid_argument);
+    EXPECT_FALSE(scheduler.getBuildingAssignment("Build 0").has_value()); //not scheduled yet
+
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    scheduler.schedule();
+    EXPECT_THROW(scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY), std::invalid_argument);
+
+    auto build0 = scheduler.getBuildingAssignment("Build 0");
+    ASSERT_TRUE(build0.has_value());
+    EXPECT_EQ(0, build0->day);
+    EXPECT_EQ(1, scheduler.getSchedule()[0].size());
+}
+
+TEST_F(SchedulerTest, duplicateEmployeeIdLeavesTheOldTypePools) {
+    // laborer on Monday, then an installer on Tuesday only: no two-story crew can be put together on either day
+    scheduler.addEmployee(5, EmployeeType::LABORER, {true, false, false, false, false});
+    scheduler.addEmployee(5, EmployeeType::CERTIFIED_INSTALLER, {false, true, false, false, false});
+    scheduler.addEmployee(6, EmployeeType::CERTIFIED_INSTALLER, {true, false, false, false, false});
+    scheduler.addBuilding("Build 1", BuildingType::TWO_STORY);
+    scheduler.schedule();
+
+    for (const auto& day : scheduler.getSchedule()) {
+        EXPECT_TRUE(day.empty());
+    }
+    Scheduler restored;
+    restored.loadSnapshot(scheduler.saveSnapshot());
+    EXPECT_EQ(scheduler.getSchedule(), restored.getSchedule());
+}
+
+TEST_F(SchedulerTest, nearestPolicyPrefersCloseCrews) {
+    // two sites at opposite ends of town, each with a crew living next to it
+    scheduler.addBuilding("North", BuildingType::TWO_STORY, {0.0, 40.0});
+    scheduler.addBuilding("South", BuildingType::TWO_STORY, {0.0, 0.0});
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}, {0.5, 40.0});
+    scheduler.addEmployee(2, EmployeeType::LABORER, {true, true, true, true, true}, {0.0, 39.0});
+    scheduler.addEmployee(3, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}, {1.0, 0.0});
+    scheduler.addEmployee(4, EmployeeType::LABORER, {true, true, true, true, true}, {0.0, 1.5});
+
+    Scheduler greedy;
+    greedy.addBuilding("North", BuildingType::TWO_STORY, {0.0, 40.0});
+    greedy.addBuilding("South", BuildingType::TWO_STORY, {0.0, 0.0});
+    greedy.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}, {0.5, 40.0});
+    greedy.addEmployee(2, EmployeeType::LABORER, {true, true, true, true, true}, {0.0, 39.0});
+    greedy.addEmployee(3, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}, {1.0, 0.0});
+    greedy.addEmployee(4, EmployeeType::LABORER, {true, true, true, true, true}, {0.0, 1.5});
+    greedy.schedule();
+
+    scheduler.setAssignmentPolicy(AssignmentPolicy::NEAREST);
+    scheduler.schedule();
+    scheduler.printSchedule();
+
+    auto schedule = scheduler.getSchedule();
+    ASSERT_EQ(2, schedule[0].size());
+    EXPECT_EQ("North", schedule[0][0].first);
+    EXPECT_EQ(std::vector<int>({1, 2}), schedule[0][0].second);
+    EXPECT_EQ("South", schedule[0][1].first);
+    EXPECT_EQ(std::vector<int>({3, 4}), schedule[0][1].second);
+    EXPECT_DOUBLE_EQ(4.0, scheduler.getTravelDistance());
+    // the greedy policy sends the last added employees north
+    EXPECT_GT(greedy.getTravelDistance(), 70.0);
+}
+
+TEST_F(SchedulerTest, copyOutlivesTheSource) {
+    auto copy = std::make_unique<Scheduler>();
+    {
+        Scheduler source;
+        source.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+        source.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+        source.schedule();
+        *copy = source;
+    }
+
+    auto build0 = copy->getBuildingAssignment("Build 0");
+    ASSERT_TRUE(build0.has_value());
+    EXPECT_EQ(std::vector<int>({1}), std::vector<int>(build0->crew.begin(), build0->crew.end()));
+    ASSERT_EQ(1, copy->getEmployeeAssignments(1).size());
+    EXPECT_EQ("Build 0", copy->getEmployeeAssignments(1)[0].building);
+}
+
+TEST_F(SchedulerTest, schedulingACopyLeavesTheSource) {
+    scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    scheduler.setAssignmentPolicy(AssignmentPolicy::LEAST_ASSIGNED);
+
+    Scheduler copy(scheduler);
+    copy.schedule();
+
+    EXPECT_EQ(SHIFT_HOURS, copy.getAssignedHours(1));
+    EXPECT_EQ(0, scheduler.getAssignedHours(1));
+    EXPECT_TRUE(scheduler.getSchedule()[0].empty());
+    scheduler.schedule();
+    EXPECT_EQ(copy.getSchedule(), scheduler.getSchedule());
+}
+
+namespace {
+// runs the posted tasks one at a time when drained, like an event loop owned by the caller
+struct ManualExecutor {
+    std::deque<std::function<void()>> tasks;
+
+    ScheduleExecutor_Type executor() {
+        return [this](std::function<void()> task) { tasks.push_back(std::move(task)); };
+    }
+
+    int drain() {
+        int ran = 0;
+        while (!tasks.empty()) {
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            task();
+            ran++;
+        }
+        return ran;
+    }
+};
+
+void loadCity(Scheduler& scheduler) {
+    static const Workload city = [] {
+        std::mt19937 rng(30);
+        return randomWorkload(rng, 30, 40, 0);
+    }();
+    loadWorkload(scheduler, city);
+}
+}
+
+TEST_F(SchedulerTest, scheduleAsyncMatchesSchedule) {
+    loadCity(scheduler);
+    Scheduler reference;
+    loadCity(reference);
+    reference.schedule();
+
+    ManualExecutor loop;
+    std::vector<ScheduleProgress> progress;
+    auto result = scheduler.scheduleAsync(loop.executor(), {}, [&](const ScheduleProgress& p) { progress.push_back(p); }, 4);
+    EXPECT_EQ(std::future_status::timeout, result.wait_for(std::chrono::seconds(0)));
+
+    int tasks = loop.drain();
+    ASSERT_EQ(std::future_status::ready, result.wait_for(std::chrono::seconds(0)));
+    EXPECT_EQ(ScheduleStatus::COMPLETED, result.get());
+    EXPECT_EQ(reference.getSchedule(), scheduler.getSchedule());
+
+    // one progress report per task, the work is split in chunks of at most 4 buildings
+    EXPECT_EQ(tasks, progress.size());
+    EXPECT_GT(tasks, 30 / 4);
+    for (std::size_t p = 1; p < progress.size(); p++) {
+        EXPECT_LE(progress[p - 1].day, progress[p].day);
+        EXPECT_LE(progress[p - 1].buildingsScheduled, progress[p].buildingsScheduled);
+        EXPECT_GE(progress[p - 1].buildingsPending, progress[p].buildingsPending);
+        EXPECT_EQ(30, progress[p].buildingsScheduled + progress[p].buildingsPending);
+    }
+    EXPECT_EQ(WORK_DAYS, progress.back().day);
+    std::size_t scheduled = 0;
+    for (const auto& day : scheduler.getSchedule()) {
+        scheduled += day.size();
+    }
+    EXPECT_EQ(scheduled, progress.back().buildingsScheduled);
+}
+
+TEST_F(SchedulerTest, scheduleAsyncStopsWithPartialSchedule) {
+    loadCity(scheduler);
+    scheduler.setAssignmentPolicy(AssignmentPolicy::LEAST_ASSIGNED);
+    Scheduler reference = scheduler;
+    reference.schedule();
+
+    // a deadline reached after three chunks
+    ManualExecutor loop;
+    std::stop_source deadline;
+    int chunks = 0;
+    auto result = scheduler.scheduleAsync(loop.executor(), deadline.get_token(), [&](const ScheduleProgress&) {
+        if (++chunks == 3) {
+            deadline.request_stop();
+        }
+    }, 5);
+    loop.drain();
+    EXPECT_EQ(ScheduleStatus::CANCELLED, result.get());
+    EXPECT_EQ(3, chunks);
+
+    // what was placed is the start of the full schedule, in the same order
+    std::vector<std::pair<std::string, std::vector<int>>> partial, full;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        partial.insert(partial.end(), scheduler.getSchedule()[day].begin(), scheduler.getSchedule()[day].end());
+        full.insert(full.end(), reference.getSchedule()[day].begin(), reference.getSchedule()[day].end());
+    }
+    ASSERT_FALSE(partial.empty());
+    ASSERT_LT(partial.size(), full.size());
+    EXPECT_TRUE(std::equal(partial.begin(), partial.end(), full.begin()));
+
+    // the buildings not reached are kept for the next run
+    scheduler.schedule();
+    std::size_t placed = 0;
+    for (const auto& day : scheduler.getSchedule()) {
+        placed += day.size();
+    }
+    EXPECT_GT(placed, partial.size());
+}
+
+TEST_F(SchedulerTest, scheduleAsyncStoppedBeforeStart) {
+    loadCity(scheduler);
+    std::stop_source deadline;
+    deadline.request_stop();
+
+    ManualExecutor loop;
+    auto result = scheduler.scheduleAsync(loop.executor(), deadline.get_token());
+    EXPECT_EQ(1, loop.drain());
+    EXPECT_EQ(ScheduleStatus::CANCELLED, result.get());
+    for (const auto& day : scheduler.getSchedule()) {
+        EXPECT_TRUE(day.empty());
+    }
+
+    // the next run schedules everything, the buildings kept their names
+    scheduler.schedule();
+    Scheduler reference;
+    loadCity(reference);
+    reference.schedule();
+    EXPECT_EQ(reference.getSchedule(), scheduler.getSchedule());
+}
+
+TEST_F(SchedulerTest, scheduleAsyncOnWorkerThread) {
+    loadCity(scheduler);
+    Scheduler reference;
+    loadCity(reference);
+    reference.schedule();
+
+    // every chunk on a fresh thread, none of them waits for the next one
+    std::vector<std::jthread> workers;
+    std::mutex workers_mutex;
+    auto result = scheduler.scheduleAsync([&](std::function<void()> task) {
+        std::lock_guard<std::mutex> lock(workers_mutex);
+        workers.emplace_back(std::move(task));
+    }, {}, {}, 2);
+    EXPECT_EQ(ScheduleStatus::COMPLETED, result.get());
+    EXPECT_EQ(reference.getSchedule(), scheduler.getSchedule());
+
+    std::lock_guard<std::mutex> lock(workers_mutex);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+TEST_F(SchedulerTest, scheduleAsyncForwardsCallbackErrors) {
+    loadCity(scheduler);
+    ManualExecutor loop;
+    auto result = scheduler.scheduleAsync(loop.executor(), {}, [](const ScheduleProgress&) {
+        throw std::runtime_error("handler gone");
+    });
+    loop.drain();
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST_F(SchedulerTest, capacityReportNamesTheShortfall) {
+    scheduler.addBuilding("Mall", BuildingType::COMMERCIAL);
+    scheduler.addBuilding("House", BuildingType::SINGLE_STORY);
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    scheduler.addEmployee(2, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, true, true, true});
+    scheduler.addEmployee(3, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, true, true, true});
+    for (int id = 4; id <= 7; id++) {
+        scheduler.addEmployee(id, EmployeeType::LABORER, {true, true, true, true, true});
+    }
+    scheduler.schedule();
+    EXPECT_TRUE(scheduler.getCapacityReport().unscheduled.empty()); //diagnostics are off by default
+
+    Scheduler diagnosed;
+    diagnosed.setDiagnostics(true);
+    diagnosed.addBuilding("Mall", BuildingType::COMMERCIAL);
+    diagnosed.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {false, false, false, true, false});
+    diagnosed.addEmployee(2, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, true, true, true});
+    diagnosed.addEmployee(3, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, true, true, true});
+    for (int id = 4; id <= 7; id++) {
+        diagnosed.addEmployee(id, EmployeeType::LABORER, {true, true, true, true, true});
+    }
+    diagnosed.schedule();
+
+    const CapacityReport& report = diagnosed.getCapacityReport();
+    ASSERT_EQ(1, report.unscheduled.size());
+    const UnscheduledBuilding& mall = report.unscheduled[0];
+    EXPECT_EQ("Mall", mall.name);
+    // thursday has the one certified installer, the 2/2/4 crew is one certified installer short
+    EXPECT_EQ(static_cast<int>(DayOfWeek::THURSDAY), mall.closestDay);
+    const DayShortfall& thursday = mall.days[mall.closestDay];
+    EXPECT_EQ((std::array<int, EMPLOYEE_TYPES>{2, 2, 4}), thursday.required);
+    EXPECT_EQ((std::array<int, EMPLOYEE_TYPES>{1, 0, 0}), thursday.missing);
+    EXPECT_EQ((std::array<int, EMPLOYEE_TYPES>{2, 0, 0}), mall.days[0].missing);
+    for (const auto& day : mall.days) {
+        EXPECT_GE(day.alternative, 0);
+    }
+    EXPECT_EQ(std::vector<std::string>({"need 1 more certified installer on Thursday"}), report.describe());
+}
+
+TEST_F(SchedulerTest, memoryUsageCountsTheDiagnostics) {
+    scheduler.addBuilding("Mall", BuildingType::COMMERCIAL);
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    Scheduler diagnosed = scheduler;
+    diagnosed.setDiagnostics(true);
+    scheduler.schedule();
+    diagnosed.schedule();
+
+    MemoryUsage plain = scheduler.memoryUsage();
+    MemoryUsage usage = diagnosed.memoryUsage();
+    EXPECT_EQ(0, plain.diagnostics);
+    ASSERT_EQ(1, diagnosed.getCapacityReport().unscheduled.size());
+    EXPECT_GE(usage.diagnostics, sizeof(UnscheduledBuilding) + sizeof(std::array<DayShortfall, WORK_DAYS>));
+}
+
+TEST_F(SchedulerTest, capacityGapCountsCompetingBuildings) {
+    scheduler.setDiagnostics(true);
+    for (int b = 0; b < 3; b++) {
+        scheduler.addBuilding("House " + std::to_string(b), BuildingType::SINGLE_STORY);
+    }
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, false, false, false, false});
+    scheduler.schedule();
+
+    // one house gets the only installer, the other two both miss one on every day
+    const CapacityReport& report = scheduler.getCapacityReport();
+    ASSERT_EQ(2, report.unscheduled.size());
+    EXPECT_EQ("House 1", report.unscheduled[0].name);
+    EXPECT_EQ("House 2", report.unscheduled[1].name);
+    EXPECT_EQ(0, report.unscheduled[0].closestDay);
+    EXPECT_EQ(2, report.gap[0][static_cast<int>(EmployeeType::CERTIFIED_INSTALLER)]);
+    EXPECT_EQ(std::vector<std::string>({"need 2 more certified installers on Monday"}), report.describe());
+
+    // enough staff, nothing to report
+    scheduler.addEmployee(2, EmployeeType::CERTIFIED_INSTALLER, {false, true, true, false, false});
+    scheduler.schedule();
+    EXPECT_TRUE(scheduler.getCapacityReport().unscheduled.empty());
+    EXPECT_TRUE(scheduler.getCapacityReport().describe().empty());
+}
+
+TEST_F(SchedulerTest, diagnosticsDontChangeTheSchedule) {
+    for (const auto& policy : {AssignmentPolicy::GREEDY, AssignmentPolicy::LEAST_ASSIGNED, AssignmentPolicy::NEAREST}) {
+        Scheduler plain;
+        loadCity(plain);
+        plain.setAssignmentPolicy(policy);
+        Scheduler diagnosed = plain;
+        diagnosed.setDiagnostics(true);
+
+        plain.schedule();
+        diagnosed.schedule();
+        EXPECT_EQ(plain.getSchedule(), diagnosed.getSchedule());
+
+        std::size_t scheduled = 0;
+        for (const auto& day : diagnosed.getSchedule()) {
+            scheduled += day.size();
+        }
+        EXPECT_EQ(30 - scheduled, diagnosed.getCapacityReport().unscheduled.size());
+    }
+}
+
+TEST_F(SchedulerTest, snapshotRoundTrip) {
+    loadCity(scheduler);
+    scheduler.setAssignmentPolicy(AssignmentPolicy::LEAST_ASSIGNED);
+    scheduler.setWeeklyHourCap(24);
+    scheduler.schedule();
+
+    Scheduler restored;
+    restored.loadSnapshot(scheduler.saveSnapshot());
+    EXPECT_EQ(scheduler.getSchedule(), restored.getSchedule());
+    EXPECT_DOUBLE_EQ(scheduler.getTravelDistance(), restored.getTravelDistance());
+    for (int id = 1; id <= 40; id++) {
+        EXPECT_EQ(scheduler.getAssignedHours(id), restored.getAssignedHours(id));
+        EXPECT_EQ(scheduler.getEmployeeAssignments(id).size(), restored.getEmployeeAssignments(id).size());
+    }
+    auto build = restored.getBuildingAssignment("Build 3");
+    ASSERT_TRUE(build.has_value());
+    EXPECT_EQ(scheduler.getBuildingAssignment("Build 3")->day, build->day);
+
+    // both carry on the same way
+    for (Scheduler* each : {&scheduler, &restored}) {
+        each->addBuilding("Late", BuildingType::TWO_STORY);
+        each->updateAvailability(7, {true, true, true, true, true});
+        each->schedule();
+    }
+    EXPECT_EQ(scheduler.getSchedule(), restored.getSchedule());
+    EXPECT_EQ(scheduler.saveSnapshot(), scheduler.saveSnapshot());
+}
+
+TEST_F(SchedulerTest, malformedSnapshotKeepsTheState) {
+    loadCity(scheduler);
+    scheduler.schedule();
+    std::string bytes = scheduler.saveSnapshot();
+    const auto schedule = scheduler.getSchedule();
+
+    EXPECT_THROW(scheduler.loadSnapshot(""), std::runtime_error);
+    EXPECT_THROW(scheduler.loadSnapshot(std::string_view(bytes).substr(0, bytes.size() / 2)), std::runtime_error);
+    EXPECT_THROW(scheduler.loadSnapshot(bytes + "x"), std::runtime_error);
+    EXPECT_EQ(schedule, scheduler.getSchedule());
+}
+
+namespace {
+struct SnapshotEmployee {
+    int id;
+    EmployeeType type;
+    std::uint8_t availability; //bit per day
+};
+
+// a snapshot written field by field in the layout of scheduler_snapshot.cpp, so it can describe a state the scheduler
+// never gets into: the employees, the day pools of one type and the crew of "Build 0" on Monday
+std::string writeSnapshot(const std::vector<SnapshotEmployee>& employees, EmployeeType poolType,
+                          const std::array<std::vector<int>, WORK_DAYS>& pools, const std::vector<int>& mondayCrew = {}) {
+    std::string bytes;
+    bytes.push_back(1); //format version
+    bytes.push_back(static_cast<char>(AssignmentPolicy::GREEDY));
+    putSigned(bytes, 0); //weekly hour cap
+    putSigned(bytes, 0); //assignment sequence
+    putDouble(bytes, 0.0); //travel distance
+    bytes.push_back(0); //diagnostics
+    putVarint(bytes, employees.size());
+    for (const auto& employee : employees) {
+        putSigned(bytes, employee.id);
+        bytes.push_back(static_cast<char>(employee.type));
+        bytes.push_back(static_cast<char>(employee.availability));
+        putDouble(bytes, 0.0);
+        putDouble(bytes, 0.0);
+        putSigned(bytes, 0); //assigned hours
+        putSigned(bytes, 0); //last assignment
+    }
+    putVarint(bytes, 1);
+    bytes.push_back(static_cast<char>(poolType));
+    for (const auto& pool : pools) {
+        putVarint(bytes, pool.size());
+        for (int empId : pool) {
+            putSigned(bytes, empId);
+        }
+    }
+    putVarint(bytes, 0); //no buildings left
+    for (int day = 0; day < WORK_DAYS; day++) {
+        if (day != 0 || mondayCrew.empty()) {
+            putVarint(bytes, 0);
+            continue;
+        }
+        putVarint(bytes, 1);
+        putText(bytes, "Build 0");
+        putVarint(bytes, mondayCrew.size());
+        for (int empId : mondayCrew) {
+            putSigned(bytes, empId);
+        }
+    }
+    return bytes;
+}
+}
+
+TEST_F(SchedulerTest, inconsistentSnapshotKeepsTheState) {
+    loadCity(scheduler);
+    scheduler.schedule();
+    const auto schedule = scheduler.getSchedule();
+
+    // installer 1 works every day, installer 2 on Mondays, laborer 3 built the house on Monday
+    const std::vector<SnapshotEmployee> roster = {
+        {1, EmployeeType::CERTIFIED_INSTALLER, 0b11111},
+        {2, EmployeeType::CERTIFIED_INSTALLER, 0b00001},
+        {3, EmployeeType::LABORER, 0b00001}
+    };
+    Scheduler consistent;
+    consistent.loadSnapshot(writeSnapshot(roster, EmployeeType::CERTIFIED_INSTALLER, {{{1, 2}, {1}, {1}, {1}, {1}}}, {3}));
+    ASSERT_EQ(1, consistent.getSchedule()[0].size());
+    EXPECT_EQ(std::vector<int>({3}), consistent.getSchedule()[0][0].second);
+
+    const std::vector<std::string> inconsistent = {
+        writeSnapshot({roster[0], roster[0]}, EmployeeType::CERTIFIED_INSTALLER, {{{1}, {}, {}, {}, {}}}), //same id twice
+        writeSnapshot(roster, EmployeeType::CERTIFIED_INSTALLER, {{{1, 2, 1}, {}, {}, {}, {}}}),          //twice in a pool
+        writeSnapshot(roster, EmployeeType::LABORER, {{{1}, {}, {}, {}, {}}}),                            //installer as laborer
+        writeSnapshot(roster, EmployeeType::CERTIFIED_INSTALLER, {{{1}, {1, 2}, {}, {}, {}}}),            //2 on a Tuesday
+        writeSnapshot(roster, EmployeeType::CERTIFIED_INSTALLER, {{{1}, {}, {}, {}, {}}}, {3, 9})         //unknown crew member
+    };
+    for (std::size_t s = 0; s < inconsistent.size(); s++) {
+        EXPECT_THROW(scheduler.loadSnapshot(inconsistent[s]), std::runtime_error) << "snapshot " << s;
+        EXPECT_EQ(schedule, scheduler.getSchedule());
+    }
+}
+
+TEST_F(SchedulerTest, perSchedulerBuildingRequirements) {
+    // a customer who lets a laborer alone build single-story houses and never builds commercial ones
+    auto rules = std::make_shared<Scheduler::BuildingRequrement_Type>(Scheduler::BuildingRequrement_Type{
+        {BuildingType::SINGLE_STORY, {{{EmployeeType::LABORER, 1}}}}
+    });
+    Scheduler custom;
+    custom.setBuildingRequirements(rules);
+    for (Scheduler* each : {&scheduler, &custom}) {
+        each->addBuilding("House", BuildingType::SINGLE_STORY);
+        each->addBuilding("Mall", BuildingType::COMMERCIAL);
+        each->addEmployee(1, EmployeeType::LABORER, {true, true, true, true, true});
+        each->schedule();
+    }
+
+    EXPECT_FALSE(scheduler.getBuildingAssignment("House").has_value());
+    auto house = custom.getBuildingAssignment("House");
+    ASSERT_TRUE(house.has_value());
+    EXPECT_EQ(std::vector<int>({1}), std::vector<int>(house->crew.begin(), house->crew.end()));
+    EXPECT_FALSE(custom.getBuildingAssignment("Mall").has_value());
+
+    custom.setBuildingRequirements(nullptr);
+    custom.addBuilding("Other house", BuildingType::SINGLE_STORY);
+    custom.schedule();
+    EXPECT_FALSE(custom.getBuildingAssignment("Other house").has_value());
+}
@@ -0,0 +1,263 @@
+#include <iostream>
+#include <algorithm>
+#include <bit>
+
+#include "skill_scheduler.h"
+
+using namespace std;
+
+namespace {
+const SkillSet certifiedSlot = skillSetOf({Skill::INSTALLATION, Skill::CERTIFICATION});
+const SkillSet installerSlot = skillSetOf({Skill::INSTALLATION});
+const SkillSet laborSlot = skillSetOf({Skill::LABOR});
+
+constexpr int BITS_PER_WORD = 64;
+
+void setBit(vector<uint64_t>& bits, int index, bool value) {
+    if (static_cast<int>(bits.size()) * BITS_PER_WORD <= index) {
+        bits.resize(index / BITS_PER_WORD + 1, 0);
+    }
+    if (value) {
+        bits[index / BITS_PER_WORD] |= uint64_t{1} << (index % BITS_PER_WORD);
+    } else {
+        bits[index / BITS_PER_WORD] &= ~(uint64_t{1} << (index % BITS_PER_WORD));
+    }
+}
+}
+
+// same alternatives and order as defaultBuildingRequirements
+const SkillScheduler::SkillRequirement_Type SkillScheduler::buildingRequirements = {
+            {BuildingType::SINGLE_STORY, {{{certifiedSlot, 1}}}},
+            {BuildingType::TWO_STORY, {{{certifiedSlot, 1}, {laborSlot, 1}},
+                                       {{certifiedSlot, 1}, {installerSlot, 1}}}},
+            {BuildingType::COMMERCIAL, {{{certifiedSlot, 2}, {installerSlot, 2}, {laborSlot, 4}},
+                                        {{certifiedSlot, 6}, {installerSlot, 2}},
+                                        {{certifiedSlot, 2}, {installerSlot, 6}}}}
+        };
+
+SkillScheduler::SkillScheduler():
+    __buildings(),
+    __employees(),
+    __employee_index_by_id(),
+    __available_by_day(),
+    __holders_by_skills(),
+    __employees_by_skill_count(),
+    __daily_schedule(),
+    __building_requirements(&buildingRequirements, [](const SkillRequirement_Type*) {}) //static, not owned
+    {}
+
+void SkillScheduler::setBuildingRequirements(std::shared_ptr<const SkillRequirement_Type> requirements) {
+    if (!requirements) {
+        requirements = std::shared_ptr<const SkillRequirement_Type>(&buildingRequirements, [](const SkillRequirement_Type*) {});
+    }
+    __building_requirements = std::move(requirements);
+}
+
+
+void SkillScheduler::addEmployee(const int& employeeId, const SkillSet& empSkills, const std::vector<bool>& empAvailability) {
+    auto found = __employee_index_by_id.find(employeeId);
+    int index;
+    if (found != __employee_index_by_id.end()) {
+        index = found->second;
+        setBit(__employees_by_skill_count[__employees[index].skills.count()], index, false);
+        __employees[index].skills = empSkills;
+    } else {
+        index = static_cast<int>(__employees.size());
+        __employee_index_by_id[employeeId] = index;
+        __employees.push_back(__SkillEmployee{employeeId, std::nullopt, empSkills, empAvailability});
+    }
+    setBit(__employees_by_skill_count[empSkills.count()], index, true);
+
+    for (auto& [skills, holders] : __holders_by_skills) {
+        setBit(holders, index, (empSkills & skills) == skills);
+    }
+    updateAvailability(employeeId, empAvailability);
+}
+
+void SkillScheduler::addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability) {
+    addEmployee(employeeId, skillSetOf(empType), empAvailability);
+    __employees[__employee_index_by_id[employeeId]].type = empType;
+}
+
+void SkillScheduler::addBuilding(const std::string& buildName, const BuildingType& buildType) {
+    __buildings.push_back(Building(buildName, buildType));
+}
+
+void SkillScheduler::updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability) {
+    int index = __employee_index_by_id.at(employeeId);
+    for (int day = 0; day < WORK_DAYS; day++) {
+        setBit(__available_by_day[day], index, newAvailability[day]);
+    }
+    __employees[index].availability = newAvailability;
+}
+
+void SkillScheduler::schedule() {
+    for (int day = 0; day < WORK_DAYS; day++) {
+        for (auto it = __buildings.begin(); it != __buildings.end(); ) {
+            std::vector<int> assignedEmployees;
+
+            if (__canBuild(*it, day, assignedEmployees)) {
+                __daily_schedule[day].push_back(make_pair(it->name, std::move(assignedEmployees)));
+                it = __buildings.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+const SkillScheduler::__EmployeeBitset_Type& SkillScheduler::__holdersOf(const SkillSet& skills) {
+    auto found = __holders_by_skills.find(skills);
+    if (found != __holders_by_skills.end()) {
+        return found->second;
+    }
+
+    __EmployeeBitset_Type& holders = __holders_by_skills[skills];
+    holders.assign((__employees.size() + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+    for (int index = 0; index < static_cast<int>(__employees.size()); index++) {
+        if ((__employees[index].skills & skills) == skills) {
+            setBit(holders, index, true);
+        }
+    }
+    return holders;
+}
+
+bool SkillScheduler::__canBuild(const Building& building, int day, std::vector<int>& assignedEmployees) {
+    const __EmployeeBitset_Type& available = __available_by_day[day];
+    auto conditions = __building_requirements->find(building.type);
+    if (conditions == __building_requirements->end()) {
+        return false;
+    }
+
+    for (const SkillAlternative_Type& alternative : conditions->second) {
+        // one candidate pool per requirement: available employees holding its skills
+        std::vector<__EmployeeBitset_Type> pools;
+        pools.reserve(alternative.size());
+        bool cond_met_so_far = true;
+        for (const auto& [skills, count] : alternative) {
+            const __EmployeeBitset_Type& holders = __holdersOf(skills);
+            __EmployeeBitset_Type pool(available.size(), 0);
+            int candidates = 0;
+            for (size_t word = 0; word < pool.size() && word < holders.size(); word++) {
+                pool[word] = available[word] & holders[word];
+                candidates += popcount(pool[word]);
+            }
+            if (candidates < count) {
+                cond_met_so_far = false;
+                break;
+            }
+            pools.push_back(std::move(pool));
+        }
+        if (!cond_met_so_far) {
+            continue;
+        }
+
+        // one slot per worker, the most specific requirements first so they get the specialists
+        std::vector<int> requirementOfSlot;
+        for (int req = 0; req < static_cast<int>(alternative.size()); req++) {
+            requirementOfSlot.insert(requirementOfSlot.end(), alternative[req].second, req);
+        }
+        std::stable_sort(requirementOfSlot.begin(), requirementOfSlot.end(), [&](int lhs, int rhs) {
+            return alternative[lhs].first.count() > alternative[rhs].first.count();
+        });
+        std::vector<const __EmployeeBitset_Type*> slotCandidates;
+        slotCandidates.reserve(requirementOfSlot.size());
+        for (int req : requirementOfSlot) {
+            slotCandidates.push_back(&pools[req]);
+        }
+
+        std::vector<int> employeeOfSlot;
+        if (!__matchSlots(slotCandidates, employeeOfSlot)) {
+            continue;
+        }
+
+        // crew listed in requirement order, like Scheduler
+        std::vector<int> slotOrder(requirementOfSlot.size());
+        for (int slot = 0; slot < static_cast<int>(slotOrder.size()); slot++) {
+            slotOrder[slot] = slot;
+        }
+        std::stable_sort(slotOrder.begin(), slotOrder.end(), [&](int lhs, int rhs) {
+            return requirementOfSlot[lhs] < requirementOfSlot[rhs];
+        });
+        for (int slot : slotOrder) {
+            int index = employeeOfSlot[slot];
+            setBit(__available_by_day[day], index, false);
+            assignedEmployees.push_back(__employees[index].id);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool SkillScheduler::__matchSlots(const std::vector<const __EmployeeBitset_Type*>& slotCandidates, std::vector<int>& employeeOfSlot) {
+    // Kuhn's augmenting paths, each search walks the unvisited candidates of a slot word by word
+    employeeOfSlot.assign(slotCandidates.size(), -1);
+    std::vector<int> slotOfEmployee(__employees.size(), -1);
+    __EmployeeBitset_Type visited;
+    for (int slot = 0; slot < static_cast<int>(slotCandidates.size()); slot++) {
+        visited.assign(slotCandidates[slot]->size(), 0);
+        if (!__augment(slot, slotCandidates, employeeOfSlot, slotOfEmployee, visited)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SkillScheduler::__augment(int slot, const std::vector<const __EmployeeBitset_Type*>& slotCandidates, std::vector<int>& employeeOfSlot,
+                               std::vector<int>& slotOfEmployee, __EmployeeBitset_Type& visited) {
+    const __EmployeeBitset_Type& candidates = *slotCandidates[slot];
+    // a free candidate first, so crews already matched are only reshuffled when needed
+    for (const auto& [skillCount, tier] : __employees_by_skill_count) {
+        for (size_t word = 0; word < candidates.size() && word < tier.size(); word++) {
+            uint64_t open = candidates[word] & tier[word] & ~visited[word];
+            while (open != 0) {
+                int bit = countr_zero(open);
+                open &= open - 1;
+                int index = static_cast<int>(word) * BITS_PER_WORD + bit;
+                if (slotOfEmployee[index] == -1) {
+                    visited[word] |= uint64_t{1} << bit;
+                    slotOfEmployee[index] = slot;
+                    employeeOfSlot[slot] = index;
+                    return true;
+                }
+            }
+        }
+    }
+
+    for (const auto& [skillCount, tier] : __employees_by_skill_count) {
+        for (size_t word = 0; word < candidates.size() && word < tier.size(); word++) {
+            uint64_t open = candidates[word] & tier[word] & ~visited[word];
+            while (open != 0) {
+                int bit = countr_zero(open);
+                open &= open - 1;
+                int index = static_cast<int>(word) * BITS_PER_WORD + bit;
+                visited[word] |= uint64_t{1} << bit;
+                if (slotOfEmployee[index] == -1 || __augment(slotOfEmployee[index], slotCandidates, employeeOfSlot, slotOfEmployee, visited)) {
+                    slotOfEmployee[index] = slot;
+                    employeeOfSlot[slot] = index;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void SkillScheduler::printSchedule() const {
+    cout << "************ SCHEDULE ***************" << endl;
+    for (DayOfWeek currDay = DayOfWeek::MONDAY; static_cast<int>(currDay) < WORK_DAYS; ++currDay) {
+        for (const auto& buldingAssignedEmpsPair : __daily_schedule[static_cast<int>(currDay)]) {
+            cout << dayToStr.at(currDay) << ": ";
+            cout << "Building -> " << buldingAssignedEmpsPair.first << ": | Employees -> ";
+            for (const auto& empId : buldingAssignedEmpsPair.second) {
+                cout << "[" << empId << "] ";
+            }
+            cout << endl;
+        }
+    }
+    cout << "*************************************" << endl;
+}
+
+const SkillScheduler::__DailySchedule_Type& SkillScheduler::getSchedule() const {
+    return __daily_schedule;
+}
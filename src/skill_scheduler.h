@@ -0,0 +1,67 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <map>
+#include <utility>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "employee.h"
+#include "building.h"
+#include "days.h"
+
+
+// Scheduler whose requirements are expressed on skills instead of exact employee types:
+// an alternative is a list of "N workers having skills ⊇ S", so any employee carrying the skills can fill the slot
+// (e.g. a certified installer can fill a laborer slot when no laborer is left). Crews are found with bipartite matching between slots and
+// available employees, candidate pools are bitsets over the employees.
+class SkillScheduler {
+    public:
+        using SkillAlternative_Type = std::vector<std::pair<SkillSet, int>>; //worker count by required skills
+        using SkillRequirement_Type = std::unordered_map<BuildingType,
+                                            std::vector<SkillAlternative_Type> //tried in order, the first one staffed wins
+                                            >;
+        static const SkillRequirement_Type buildingRequirements; //Scheduler::buildingRequirements expressed on skills
+        SkillScheduler();
+        // rules used instead of buildingRequirements; nullptr restores the default
+        void setBuildingRequirements(std::shared_ptr<const SkillRequirement_Type> requirements);
+        void schedule();
+        void printSchedule() const;
+        const std::array<std::vector<std::pair<std::string, std::vector<int>>>, WORK_DAYS>& getSchedule() const;
+        void updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability);
+        void addEmployee(const int& employeeId, const SkillSet& empSkills, const std::vector<bool>& empAvailability);
+        void addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability);
+        void addBuilding(const std::string& buildName, const BuildingType& buildType);
+
+    private:
+        using __EmployeeBitset_Type = std::vector<std::uint64_t>; //one bit per employee index in __employees
+        using __DailySchedule_Type = std::array<
+                                                std::vector<
+                                                    std::pair<std::string, std::vector<int>>
+                                                >
+                                            , WORK_DAYS>;
+
+        struct __SkillEmployee {
+            int id;
+            std::optional<EmployeeType> type; //only known for employees added by type, the matching looks at the skills
+            SkillSet skills;
+            std::vector<bool> availability;
+        };
+
+        std::vector<Building> __buildings;
+        std::vector<__SkillEmployee> __employees; //employees by dense index, the bit position in the bitsets
+        std::unordered_map<int, int> __employee_index_by_id;
+        std::array<__EmployeeBitset_Type, WORK_DAYS> __available_by_day; //employees available and not assigned yet on each day
+        std::unordered_map<SkillSet, __EmployeeBitset_Type> __holders_by_skills; //employees holding all the skills of a requirement, filled lazily
+        std::map<std::size_t, __EmployeeBitset_Type> __employees_by_skill_count; //candidates are tried by ascending skill count, specialists are kept for the slots needing them
+        __DailySchedule_Type __daily_schedule;
+        std::shared_ptr<const SkillRequirement_Type> __building_requirements; //buildingRequirements unless set
+
+        bool __canBuild(const Building& building, int day, std::vector<int>& assignedEmployees); //Checks if a building can be built on a given day and fill the assigned employees vector
+        bool __matchSlots(const std::vector<const __EmployeeBitset_Type*>& slotCandidates, std::vector<int>& employeeOfSlot);
+        bool __augment(int slot, const std::vector<const __EmployeeBitset_Type*>& slotCandidates, std::vector<int>& employeeOfSlot,
+                       std::vector<int>& slotOfEmployee, __EmployeeBitset_Type& visited);
+        const __EmployeeBitset_Type& __holdersOf(const SkillSet& skills);
+};
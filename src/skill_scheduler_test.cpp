@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include "skill_scheduler.h"
+
+using namespace std;
+
+
+class SkillSchedulerTest : public testing::Test {
+  protected:
+        SkillScheduler scheduler;
+};
+
+
+TEST_F(SkillSchedulerTest, certifiedInstallerFillsLaborerSlot) {
+    // two-story needs a certified installer plus an installer or a laborer, only certified installers here
+    scheduler.addBuilding("Build 0", BuildingType::TWO_STORY);
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    scheduler.addEmployee(2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+
+    scheduler.schedule();
+    scheduler.printSchedule();
+
+    auto schedule = scheduler.getSchedule();
+    EXPECT_EQ(1, schedule[0].size());
+    EXPECT_EQ("Build 0", schedule[0][0].first);
+    EXPECT_EQ(2, schedule[0][0].second.size());
+}
+
+TEST_F(SkillSchedulerTest, specialistsKeptForSpecificSlots) {
+    // the laborer takes the laborer slot so the certified installer is left for the single-story building
+    scheduler.addBuilding("Build 0", BuildingType::TWO_STORY);
+    scheduler.addBuilding("Build 1", BuildingType::SINGLE_STORY);
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, false, false, false, false});
+    scheduler.addEmployee(2, EmployeeType::CERTIFIED_INSTALLER, {true, false, false, false, false});
+    scheduler.addEmployee(3, EmployeeType::LABORER, {true, false, false, false, false});
+    scheduler.addEmployee(4, EmployeeType::CERTIFIED_INSTALLER, {true, false, false, false, false});
+
+    scheduler.schedule();
+    scheduler.printSchedule();
+
+    auto schedule = scheduler.getSchedule();
+    EXPECT_EQ(2, schedule[0].size());
+    EXPECT_EQ(std::vector<int>({1, 3}), schedule[0][0].second);
+    EXPECT_EQ(std::vector<int>({2}), schedule[0][1].second);
+}
+
+TEST_F(SkillSchedulerTest, matchingReassignsToCompleteCrew) {
+    // first slot grabs the worker holding both skills, the augmenting path moves it to the second slot
+    const SkillSet welding = skillSetOf({static_cast<Skill>(10)});
+    const SkillSet roofing = skillSetOf({static_cast<Skill>(11)});
+    const SkillSet painting = skillSetOf({static_cast<Skill>(12)});
+    auto rules = std::make_shared<SkillScheduler::SkillRequirement_Type>(SkillScheduler::buildingRequirements);
+    (*rules)[BuildingType::SINGLE_STORY].push_back({{welding, 1}, {roofing, 1}});
+
+    SkillScheduler customScheduler;
+    customScheduler.setBuildingRequirements(rules);
+    customScheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+    customScheduler.addEmployee(1, welding | roofing, {true, false, false, false, false});
+    customScheduler.addEmployee(2, welding | painting, {true, false, false, false, false});
+
+    customScheduler.schedule();
+    auto schedule = customScheduler.getSchedule();
+
+    ASSERT_EQ(1, schedule[0].size());
+    EXPECT_EQ(std::vector<int>({2, 1}), schedule[0][0].second);
+
+    // the rules belong to customScheduler, the default crew still needs a certified installer
+    scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+    scheduler.addEmployee(1, welding | roofing, {true, false, false, false, false});
+    scheduler.addEmployee(2, welding | painting, {true, false, false, false, false});
+    scheduler.schedule();
+    EXPECT_EQ(0, scheduler.getSchedule()[0].size());
+}
+
+TEST_F(SkillSchedulerTest, dozensOfSkills) {
+    // a requirement on many skills only matches employees holding all of them
+    SkillSet required;
+    for (int skill = 20; skill < 60; skill++) {
+        required.set(skill);
+    }
+    SkillSet partial = required;
+    partial.reset(42);
+    auto rules = std::make_shared<SkillScheduler::SkillRequirement_Type>(SkillScheduler::buildingRequirements);
+    (*rules)[BuildingType::COMMERCIAL].push_back({{required, 2}});
+
+    SkillScheduler customScheduler;
+    customScheduler.setBuildingRequirements(rules);
+    customScheduler.addBuilding("Build 0", BuildingType::COMMERCIAL);
+    for (int id = 1; id <= 100; id++) {
+        customScheduler.addEmployee(id, partial, {true, true, true, true, true});
+    }
+    customScheduler.addEmployee(101, required, {false, true, true, true, true});
+    customScheduler.addEmployee(102, required, {false, false, true, true, true});
+
+    customScheduler.schedule();
+    auto schedule = customScheduler.getSchedule();
+
+    EXPECT_EQ(0, schedule[0].size());
+    EXPECT_EQ(0, schedule[1].size());
+    ASSERT_EQ(1, schedule[2].size());
+    EXPECT_EQ(std::vector<int>({101, 102}), schedule[2][0].second);
+}
+
+TEST_F(SkillSchedulerTest, onlyAvailableEmployeesAssigned) {
+    scheduler.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+    scheduler.addBuilding("Build 1", BuildingType::SINGLE_STORY);
+    scheduler.addEmployee(1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true});
+    scheduler.addEmployee(2, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, true, true, true});
+    scheduler.updateAvailability(1, {false, false, true, false, false});
+
+    scheduler.schedule();
+    scheduler.printSchedule();
+
+    auto schedule = scheduler.getSchedule();
+    // a pending installer lacks the certification skill, so only Wednesday has a crew
+    EXPECT_EQ(0, schedule[0].size());
+    EXPECT_EQ(0, schedule[1].size());
+    ASSERT_EQ(1, schedule[2].size());
+    EXPECT_EQ("Build 0", schedule[2][0].first);
+    EXPECT_EQ(std::vector<int>({1}), schedule[2][0].second);
+    EXPECT_EQ(0, schedule[3].size());
+}
+
+TEST_F(SkillSchedulerTest, substitutionRaisesUtilization) {
+    // commercial needs 2 certified, 2 installers and 4 laborers, installers stand in for the missing laborers
+    scheduler.addBuilding("Build 0", BuildingType::COMMERCIAL);
+    for (int id = 1; id <= 2; id++) {
+        scheduler.addEmployee(id, EmployeeType::CERTIFIED_INSTALLER, {true, false, false, false, false});
+    }
+    for (int id = 3; id <= 7; id++) {
+        scheduler.addEmployee(id, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, false, false, false, false});
+    }
+    scheduler.addEmployee(8, EmployeeType::LABORER, {true, false, false, false, false});
+
+    scheduler.schedule();
+    scheduler.printSchedule();
+
+    auto schedule = scheduler.getSchedule();
+    ASSERT_EQ(1, schedule[0].size());
+    auto crew = schedule[0][0].second;
+    EXPECT_EQ(8, crew.size());
+    std::sort(crew.begin(), crew.end());
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8}), crew);
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+
+// 24-byte string for building names: up to INLINE_CAPACITY characters are stored in the object itself,
+// longer ones in a heap buffer of exactly their size. The last byte holds the inline size, or HEAP_TAG.
+class SmallString {
+    public:
+        static constexpr std::size_t INLINE_CAPACITY = 22;
+
+        SmallString() {
+            __bytes[sizeof(__bytes) - 1] = 0;
+        }
+
+        explicit SmallString(std::string_view text) {
+            __assign(text);
+        }
+
+        SmallString(const SmallString& other) {
+            __assign(other.view());
+        }
+
+        SmallString(SmallString&& other) noexcept {
+            std::memcpy(__bytes, other.__bytes, sizeof(__bytes));
+            other.__bytes[sizeof(__bytes) - 1] = 0;
+        }
+
+        SmallString& operator=(const SmallString& other) {
+            if (this != &other) {
+                SmallString copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        SmallString& operator=(SmallString&& other) noexcept {
+            if (this != &other) {
+                __release();
+                std::memcpy(__bytes, other.__bytes, sizeof(__bytes));
+                other.__bytes[sizeof(__bytes) - 1] = 0;
+            }
+            return *this;
+        }
+
+        ~SmallString() {
+            __release();
+        }
+
+        std::string_view view() const {
+            if (isInline()) {
+                return std::string_view(__bytes, static_cast<unsigned char>(__bytes[sizeof(__bytes) - 1]));
+            }
+            return std::string_view(__heapData(), __heapSize());
+        }
+
+        bool isInline() const {
+            return static_cast<unsigned char>(__bytes[sizeof(__bytes) - 1]) != HEAP_TAG;
+        }
+
+        std::size_t heapBytes() const {
+            return isInline() ? 0 : __heapSize();
+        }
+
+    private:
+        static constexpr unsigned char HEAP_TAG = 0xFF;
+        char __bytes[24]; //inline characters, or the heap pointer followed by the 32-bit size
+
+        char* __heapData() const {
+            char* data;
+            std::memcpy(&data, __bytes, sizeof(data));
+            return data;
+        }
+
+        std::uint32_t __heapSize() const {
+            std::uint32_t size;
+            std::memcpy(&size, __bytes + sizeof(char*), sizeof(size));
+            return size;
+        }
+
+        void __assign(std::string_view text) {
+            if (text.size() <= INLINE_CAPACITY) {
+                std::memcpy(__bytes, text.data(), text.size());
+                __bytes[sizeof(__bytes) - 1] = static_cast<char>(text.size());
+                return;
+            }
+            char* data = new char[text.size()];
+            std::memcpy(data, text.data(), text.size());
+            std::uint32_t size = static_cast<std::uint32_t>(text.size());
+            std::memcpy(__bytes, &data, sizeof(data));
+            std::memcpy(__bytes + sizeof(char*), &size, sizeof(size));
+            __bytes[sizeof(__bytes) - 1] = static_cast<char>(HEAP_TAG);
+        }
+
+        void __release() {
+            if (!isInline()) {
+                delete[] __heapData();
+                __bytes[sizeof(__bytes) - 1] = 0;
+            }
+        }
+};
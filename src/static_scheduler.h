@@ -0,0 +1,182 @@
+#pragma once
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include "employee.h"
+#include "building.h"
+#include "days.h"
+#include "building_requirements.h"
+
+
+// Scheduler variant for rule sets known at build time: the requirement table, the number of work days and
+// the number of employee/building types are template parameters, so the alternative loops of __canBuild are
+// unrolled by the compiler and the per-type counts of each alternative are constants.
+// Same public interface and same output as Scheduler, which remains the dynamic fallback.
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+class StaticScheduler {
+    public:
+        using Schedule_Type = std::array<std::vector<std::pair<std::string, std::vector<int>>>, Days>;
+
+        void schedule();
+        void printSchedule() const;
+        const Schedule_Type& getSchedule() const;
+        void updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability);
+        void addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability);
+        void addBuilding(const std::string& buildName, const BuildingType& buildType);
+
+    private:
+        static constexpr std::size_t __rule_count = Requirements.size();
+
+        // indices of the alternatives of building type B, in table order
+        template <std::size_t B>
+        static constexpr auto __rules_of_building = [] {
+            constexpr std::size_t count = [] {
+                std::size_t n = 0;
+                for (const auto& rule : Requirements) {
+                    n += static_cast<std::size_t>(rule.buildingType) == B;
+                }
+                return n;
+            }();
+            std::array<std::size_t, count> rules{};
+            std::size_t next = 0;
+            for (std::size_t r = 0; r < __rule_count; r++) {
+                if (static_cast<std::size_t>(Requirements[r].buildingType) == B) {
+                    rules[next++] = r;
+                }
+            }
+            return rules;
+        }();
+
+        using __EmployeeAvailabilityByTypeAndDay_Type = std::array<std::array<std::vector<int>, Days>, EmployeeTypes>;
+
+        std::vector<Building> __buildings;
+        std::unordered_map<int, EmployeeType> __employee_types_by_id;
+        __EmployeeAvailabilityByTypeAndDay_Type __employees_by_type_and_day; //ids of the available employees by type and day
+        Schedule_Type __daily_schedule;
+
+        bool __canBuild(const Building& building, int day, std::vector<int>& assignedEmployees);
+        template <std::size_t B, std::size_t... I>
+        bool __canBuildType(int day, std::vector<int>& assignedEmployees, std::index_sequence<I...>);
+        template <std::size_t R, std::size_t... T>
+        bool __tryRule(int day, std::vector<int>& assignedEmployees, std::index_sequence<T...>);
+};
+
+using DefaultStaticScheduler = StaticScheduler<WORK_DAYS, EMPLOYEE_TYPES, BUILDING_TYPES, defaultBuildingRequirements>;
+
+
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+void StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::addEmployee(const int& employeeId, const EmployeeType& empType, const std::vector<bool>& empAvailability) {
+    __employee_types_by_id[employeeId] = empType;
+    auto& pools = __employees_by_type_and_day[static_cast<std::size_t>(empType)];
+    for (int day = 0; day < Days; day++) {
+        if (empAvailability[day]) {
+            pools[day].push_back(employeeId);
+        }
+    }
+}
+
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+void StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::addBuilding(const std::string& buildName, const BuildingType& buildType) {
+    __buildings.push_back(Building(buildName, buildType));
+}
+
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+void StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::updateAvailability(const int& employeeId, const std::vector<bool>& newAvailability) {
+    auto& pools = __employees_by_type_and_day[static_cast<std::size_t>(__employee_types_by_id[employeeId])];
+    for (int day = 0; day < Days; day++) {
+        auto& pool = pools[day];
+        auto was_available_already = std::find(pool.begin(), pool.end(), employeeId);
+        if (newAvailability[day]) {
+            if (was_available_already == pool.end()) {
+                pool.push_back(employeeId);
+            }
+        } else if (was_available_already != pool.end()) {
+            pool.erase(was_available_already);
+        }
+    }
+}
+
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+void StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::schedule() {
+    for (int day = 0; day < Days; day++) {
+        // stable in-place compaction instead of erasing each scheduled building, keeps the order of the rest
+        auto remaining = __buildings.begin();
+        for (auto it = __buildings.begin(); it != __buildings.end(); ++it) {
+            std::vector<int> assignedEmployees;
+            if (__canBuild(*it, day, assignedEmployees)) {
+                __daily_schedule[day].push_back(std::make_pair(it->name, std::move(assignedEmployees)));
+            } else {
+                if (remaining != it) {
+                    *remaining = std::move(*it);
+                }
+                ++remaining;
+            }
+        }
+        __buildings.erase(remaining, __buildings.end());
+    }
+}
+
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+bool StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::__canBuild(const Building& building, int day, std::vector<int>& assignedEmployees) {
+    const std::size_t type = static_cast<std::size_t>(building.type);
+    // dispatch to the unrolled alternatives of the building type
+    return [&]<std::size_t... B>(std::index_sequence<B...>) {
+        return ((type == B && __canBuildType<B>(day, assignedEmployees, std::make_index_sequence<__rules_of_building<B>.size()>{})) || ...);
+    }(std::make_index_sequence<BuildingTypes>{});
+}
+
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+template <std::size_t B, std::size_t... I>
+bool StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::__canBuildType(int day, std::vector<int>& assignedEmployees, std::index_sequence<I...>) {
+    // first alternative that can be staffed wins, like the alternatives loop of Scheduler::__canBuild
+    return (__tryRule<__rules_of_building<B>[I]>(day, assignedEmployees, std::make_index_sequence<EmployeeTypes>{}) || ...);
+}
+
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+template <std::size_t R, std::size_t... T>
+bool StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::__tryRule(int day, std::vector<int>& assignedEmployees, std::index_sequence<T...>) {
+    constexpr auto staff = Requirements[R].staff;
+    const bool cond_met = ((staff[T] == 0 || static_cast<int>(__employees_by_type_and_day[T][day].size()) >= staff[T]) && ...);
+    if (!cond_met) {
+        return false;
+    }
+
+    constexpr int crew_size = (staff[T] + ... + 0);
+    assignedEmployees.reserve(crew_size);
+    ([&] {
+        auto& pool = __employees_by_type_and_day[T][day];
+        for (int workers_count = staff[T]; workers_count > 0; workers_count--) {
+            assignedEmployees.push_back(pool.back());
+            pool.pop_back();
+        }
+    }(), ...);
+    return true;
+}
+
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+void StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::printSchedule() const {
+    static_assert(Days <= WORK_DAYS, "days are printed with their dayToStr names");
+    std::cout << "************ SCHEDULE ***************" << std::endl;
+    for (DayOfWeek currDay = DayOfWeek::MONDAY; static_cast<int>(currDay) < Days; ++currDay) {
+        for (const auto& buldingAssignedEmpsPair : __daily_schedule[static_cast<int>(currDay)]) {
+            std::cout << dayToStr.at(currDay) << ": ";
+            std::cout << "Building -> " << buldingAssignedEmpsPair.first << ": | Employees -> ";
+            for (const auto& empId : buldingAssignedEmpsPair.second) {
+                std::cout << "[" << empId << "] ";
+            }
+            std::cout << std::endl;
+        }
+    }
+    std::cout << "*************************************" << std::endl;
+}
+
+template <int Days, std::size_t EmployeeTypes, std::size_t BuildingTypes, const auto& Requirements>
+const typename StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::Schedule_Type&
+StaticScheduler<Days, EmployeeTypes, BuildingTypes, Requirements>::getSchedule() const {
+    return __daily_schedule;
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "scheduler.h"
+#include "static_scheduler.h"
+#include "scheduler_invariants.h"
+
+using namespace std;
+
+
+class StaticSchedulerTest : public testing::Test {
+  protected:
+        Scheduler scheduler;
+        DefaultStaticScheduler staticScheduler;
+        std::vector<Building> buildings;
+        std::vector<Employee> employees;
+
+    void loadBoth() {
+        for (const Building& building: buildings) {
+            scheduler.addBuilding(building.name, building.type);
+            staticScheduler.addBuilding(building.name, building.type);
+        }
+
+        for (const auto& employee : employees) {
+            scheduler.addEmployee(employee.id, employee.type, employee.availability);
+            staticScheduler.addEmployee(employee.id, employee.type, employee.availability);
+        }
+    }
+};
+
+
+TEST_F(StaticSchedulerTest, sameAsDynamicOnRandomSchedule) {
+    buildings = {
+        {"Build 0", BuildingType::TWO_STORY},
+        {"Build 1", BuildingType::COMMERCIAL},
+        {"Build 2", BuildingType::TWO_STORY},
+        {"Build 3", BuildingType::SINGLE_STORY},
+        {"Build 4", BuildingType::SINGLE_STORY}
+    };
+
+    employees = {
+        {1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, false, true}},
+        {3, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, false, true, false}},
+        {4, EmployeeType::LABORER, {true, true, true, false, false}},
+        {5, EmployeeType::LABORER, {true, true, false, true, true}},
+        {6, EmployeeType::CERTIFIED_INSTALLER, {false, true, true, false, true}},
+        {7, EmployeeType::LABORER, {true, true, true, false, true}},
+        {8, EmployeeType::LABORER, {true, true, true, false, true}},
+        {9, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, false, true, false, true}},
+        {10, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, true, true, true}}
+    };
+
+    loadBoth();
+    scheduler.schedule();
+    staticScheduler.schedule();
+    staticScheduler.printSchedule();
+
+    auto schedule = staticScheduler.getSchedule();
+    // Verify exact schedule, same as SchedulerTest.randomSchedule
+    EXPECT_EQ(2, schedule[0].size());
+    EXPECT_EQ("Build 0", schedule[0][0].first);
+    EXPECT_EQ(std::vector<int>({2, 8}), schedule[0][0].second);
+    EXPECT_EQ("Build 1", schedule[1][0].first);
+    EXPECT_EQ(std::vector<int>({6, 2, 10, 3, 8, 7, 5, 4}), schedule[1][0].second);
+    EXPECT_EQ("Build 4", schedule[2][0].first);
+    EXPECT_EQ(std::vector<int>({6}), schedule[2][0].second);
+
+    EXPECT_EQ(scheduler.getSchedule(), schedule);
+}
+
+TEST_F(StaticSchedulerTest, sameAsDynamicAfterUpdateAvail) {
+    buildings = {
+        {"Build 0", BuildingType::TWO_STORY},
+        {"Build 1", BuildingType::COMMERCIAL},
+        {"Build 2", BuildingType::TWO_STORY},
+        {"Build 3", BuildingType::SINGLE_STORY},
+        {"Build 4", BuildingType::SINGLE_STORY}
+    };
+
+    employees = {
+        {1, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, true, true}},
+        {2, EmployeeType::CERTIFIED_INSTALLER, {true, true, true, false, true}},
+        {3, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, false, true, false}},
+        {4, EmployeeType::LABORER, {true, true, true, false, false}},
+        {5, EmployeeType::LABORER, {true, true, false, true, true}},
+        {6, EmployeeType::CERTIFIED_INSTALLER, {false, true, true, false, true}},
+        {7, EmployeeType::LABORER, {true, true, true, false, true}},
+        {8, EmployeeType::LABORER, {true, true, true, false, true}},
+        {9, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, false, true, false, true}},
+        {10, EmployeeType::INSTALLER_PENDING_CERTIFICATION, {true, true, true, true, true}}
+    };
+
+    loadBoth();
+    scheduler.updateAvailability(8, {false, false, false, false, false});
+    staticScheduler.updateAvailability(8, {false, false, false, false, false});
+    scheduler.updateAvailability(3, {false, true, true, true, true});
+    staticScheduler.updateAvailability(3, {false, true, true, true, true});
+    scheduler.schedule();
+    staticScheduler.schedule();
+
+    EXPECT_EQ(scheduler.getSchedule(), staticScheduler.getSchedule());
+}
+
+TEST_F(StaticSchedulerTest, sameAsDynamicOnLargeRandomInput) {
+    std::mt19937 rng(2024);
+    const Workload workload = randomWorkload(rng, 300, 120, 0, 0.7);
+    buildings = workload.buildings;
+    employees = workload.employees;
+
+    loadBoth();
+    scheduler.schedule();
+    staticScheduler.schedule();
+
+    auto schedule = staticScheduler.getSchedule();
+    int totalScheduledBuildings = 0;
+    for (int day = 0; day < WORK_DAYS; day++) {
+        totalScheduledBuildings += schedule[day].size();
+    }
+    EXPECT_GT(totalScheduledBuildings, 0);
+    EXPECT_EQ(scheduler.getSchedule(), schedule);
+}
+
+namespace {
+// two days and a single building type staffed by one laborer
+constexpr std::array<StaticRequirement<EMPLOYEE_TYPES>, 1> laborOnlyRequirements = {{
+    {BuildingType::SINGLE_STORY, {0, 0, 1}}
+}};
+}
+
+TEST(StaticSchedulerCustomRulesTest, customTableAndDays) {
+    StaticScheduler<2, EMPLOYEE_TYPES, 1, laborOnlyRequirements> custom;
+    custom.addBuilding("Build 0", BuildingType::SINGLE_STORY);
+    custom.addBuilding("Build 1", BuildingType::SINGLE_STORY);
+    custom.addBuilding("Build 2", BuildingType::SINGLE_STORY);
+    custom.addEmployee(1, EmployeeType::LABORER, {true, true});
+    custom.addEmployee(2, EmployeeType::CERTIFIED_INSTALLER, {true, true});
+
+    custom.schedule();
+    custom.printSchedule();
+
+    auto schedule = custom.getSchedule();
+    EXPECT_EQ(1, schedule[0].size());
+    EXPECT_EQ("Build 0", schedule[0][0].first);
+    EXPECT_EQ(std::vector<int>({1}), schedule[0][0].second);
+    EXPECT_EQ(1, schedule[1].size());
+    EXPECT_EQ("Build 1", schedule[1][0].first);
+}
+
+TEST(StaticSchedulerCustomRulesTest, alternativesFollowTheSharedTable) {
+    auto& alternatives = Scheduler::buildingRequirements.at(BuildingType::COMMERCIAL);
+    ASSERT_EQ(3, alternatives.size());
+    int index = 0;
+    for (const StaticRequirement<EMPLOYEE_TYPES>& requirement : defaultBuildingRequirements) {
+        if (requirement.buildingType != BuildingType::COMMERCIAL) continue;
+        Scheduler::RequirementAlternative_Type expected;
+        for (std::size_t type = 0; type < EMPLOYEE_TYPES; type++)
+            if (requirement.staff[type] > 0) expected.push_back({static_cast<EmployeeType>(type), requirement.staff[type]});
+        EXPECT_EQ(expected, alternatives[index++]);
+    }
+}
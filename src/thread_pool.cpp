@@ -0,0 +1,55 @@
+#include <algorithm>
+
+#include "thread_pool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(std::size_t threads):
+    __mutex(),
+    __wake(),
+    __tasks(),
+    __stopping(false),
+    __workers()
+    {
+        __workers.reserve(max<size_t>(threads, 1));
+        for (size_t t = 0; t < max<size_t>(threads, 1); t++) {
+            __workers.emplace_back([this] { __work(); });
+        }
+    }
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(__mutex);
+        __stopping = true;
+    }
+    __wake.notify_all();
+    __workers.clear(); //joins
+}
+
+void ThreadPool::post(std::function<void()> task) {
+    {
+        lock_guard<mutex> lock(__mutex);
+        __tasks.push_back(std::move(task));
+    }
+    __wake.notify_one();
+}
+
+std::size_t ThreadPool::size() const {
+    return __workers.size();
+}
+
+void ThreadPool::__work() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(__mutex);
+            __wake.wait(lock, [this] { return __stopping || !__tasks.empty(); });
+            if (__tasks.empty()) {
+                return; //stopping and drained
+            }
+            task = std::move(__tasks.front());
+            __tasks.pop_front();
+        }
+        task();
+    }
+}
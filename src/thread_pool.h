@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstddef>
+
+
+// Fixed number of worker threads taking tasks from one FIFO queue. Tasks posted while others wait run after
+// them, so jobs that repost themselves in small steps (see Scheduler::scheduleAsync) take turns. Tasks must not throw.
+class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t threads);
+        ~ThreadPool(); //runs the tasks still queued, then joins the workers
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void post(std::function<void()> task);
+        std::size_t size() const;
+
+    private:
+        std::mutex __mutex;
+        std::condition_variable __wake;
+        std::deque<std::function<void()>> __tasks;
+        bool __stopping;
+        std::vector<std::jthread> __workers;
+
+        void __work();
+};
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <functional>
+#include "thread_pool.h"
+
+using namespace std;
+
+
+TEST(ThreadPoolTest, runsEveryTaskBeforeDestruction) {
+    atomic<int> ran = 0;
+    {
+        ThreadPool pool(4);
+        EXPECT_EQ(4, pool.size());
+        for (int t = 0; t < 1000; t++) {
+            pool.post([&ran] { ran++; });
+        }
+    }
+    EXPECT_EQ(1000, ran);
+}
+
+TEST(ThreadPoolTest, tasksRunOnTheWorkers) {
+    mutex ids_mutex;
+    set<thread::id> ids;
+    {
+        ThreadPool pool(2);
+        for (int t = 0; t < 100; t++) {
+            pool.post([&] {
+                lock_guard<mutex> lock(ids_mutex);
+                ids.insert(this_thread::get_id());
+            });
+        }
+    }
+    EXPECT_LE(ids.size(), 2);
+    EXPECT_EQ(0, ids.count(this_thread::get_id()));
+}
+
+TEST(ThreadPoolTest, repostedTasksTakeTurns) {
+    // with one worker, two jobs reposting themselves alternate
+    vector<char> order;
+    function<void(char, int)> step; //outlives the pool, which runs the queued steps when destroyed
+    {
+        ThreadPool pool(1);
+        step = [&](char job, int left) {
+            order.push_back(job);
+            if (left > 1) {
+                pool.post([&step, job, left] { step(job, left - 1); });
+            }
+        };
+        // the worker waits until both jobs are queued
+        promise<void> queued;
+        pool.post([ready = queued.get_future().share()] { ready.wait(); });
+        pool.post([&] { step('a', 3); });
+        pool.post([&] { step('b', 3); });
+        queued.set_value();
+    }
+    EXPECT_EQ(vector<char>({'a', 'b', 'a', 'b', 'a', 'b'}), order);
+}